@@ -26,621 +26,3970 @@
  * Niki Psoma - csd5038
  */
 
+#define _GNU_SOURCE /* ppoll(), sendmmsg() */
+
 #include "microtcp.h"
+#include "microtcp_cc.h"
+#include "microtcp_pool.h"
+#include "microtcp_flow.h"
+#include "microtcp_ring.h"
 #include "../utils/crc32.h"
+#include "../utils/crc32c.h"
 #include "microtcp_errno.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
 #include <time.h>
 #include <stdbool.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <netinet/udp.h>
+#include <sys/eventfd.h>
+
+#define microtcp_set_errno(errno_) microtcp_set_errno(errno_, __func__, __LINE__)
+
+/* Sequence number comparisons, safe across the 32-bit wrap-around. */
+#define SEQ_LT(a, b) ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+#define SEQ_LEQ(a, b) ((int32_t)((uint32_t)(a) - (uint32_t)(b)) <= 0)
+#define SEQ_GT(a, b) SEQ_LT(b, a)
+#define SEQ_GEQ(a, b) SEQ_LEQ(b, a)
+
+#define MICROTCP_DATAGRAM_LEN (sizeof(microtcp_header_t) + MICROTCP_MSS)
+
+/* Segments in one UDP GSO send, bounded by the kernel's UDP_MAX_SEGMENTS and by the 64 KB of a datagram. */
+#define MICROTCP_GSO_MAX_SEGMENTS ((65507 / MICROTCP_DATAGRAM_LEN < 64) ? 65507 / MICROTCP_DATAGRAM_LEN : 64)
+
+/* Receive buffer of a datagram coalesced by UDP GRO, anything shorter would truncate it. */
+#define MICROTCP_GRO_BUFFER_LEN 65536
+
+/* Event of engine_link_wait(), beside the MICROTCP_POLL* ones: the engine has let go of the connection. */
+#define ENGINE_DETACHED (0b1 << 8)
+
+/**
+ * Segments built by send_segment() that wait to be handed to the kernel
+ * together by tx_flush(). The payloads are referenced, not copied.
+ */
+struct microtcp_tx_batch
+{
+        microtcp_header_t headers[MICROTCP_TX_BATCH];
+        struct iovec iov[MICROTCP_TX_BATCH][2];
+        struct mmsghdr messages[MICROTCP_TX_BATCH];
+        size_t count;
+
+        struct mmsghdr gso_messages[MICROTCP_TX_BATCH]; /* Runs of segments, each sent as one UDP GSO datagram */
+        size_t gso_first[MICROTCP_TX_BATCH];            /* First segment of each run */
+        union
+        {
+                uint8_t buffer[CMSG_SPACE(sizeof(uint16_t))];
+                struct cmsghdr align;
+        } gso_control; /* UDP_SEGMENT of MICROTCP_DATAGRAM_LEN, shared by all runs */
+};
+
+/**
+ * Datagrams taken from the kernel by a single recvmmsg(), into buffers of
+ * the connection's pool. They are handed out one segment at a time by
+ * receive_segment(), the next recvmmsg() is only made once all of them
+ * have been processed. With UDP GRO, a datagram may hold several segments
+ * back to back, each of the gso_size the kernel reports but the last.
+ */
+struct microtcp_rx_batch
+{
+        uint8_t *datagrams[MICROTCP_RX_BATCH];
+        struct iovec iov[MICROTCP_RX_BATCH];
+        struct mmsghdr messages[MICROTCP_RX_BATCH];
+        union
+        {
+                uint8_t buffer[CMSG_SPACE(sizeof(int))];
+                struct cmsghdr align;
+        } gro_control[MICROTCP_GRO_BATCH]; /* UDP_GRO segment size of each coalesced datagram */
+        uint8_t *gro_buffers;              /* MICROTCP_GRO_BATCH buffers of MICROTCP_GRO_BUFFER_LEN bytes, NULL without GRO */
+        struct sockaddr_in peers[MICROTCP_RX_BATCH]; /* Source of each datagram, only received by a listener */
+        size_t capacity;                   /* Datagrams a recvmmsg() may return */
+        size_t count;                      /* Datagrams returned by the last recvmmsg() */
+        size_t next;                       /* Datagram of the next segment to be handed out */
+        size_t offset;                     /* Offset of the next segment in its datagram */
+        size_t segment_len;                /* Length of the segments of that datagram, but its last */
+};
+
+/**
+ * Flags of an engine that both its thread and application threads look at.
+ */
+struct microtcp_engine_flags
+{
+        _Atomic bool sleeping; /* The engine waits for its UDP sockets, wake_fd or a timer */
+        _Atomic bool stop;     /* Set by microtcp_engine_stop() */
+};
+
+/**
+ * Connection of an engine's group. The application thread writes tx and
+ * reads rx, the engine does the opposite, and each flag is only set by the
+ * side named next to it. The engine keeps the link until it is stopped, so
+ * it may still look at the flags after it has let go of the connection.
+ */
+struct microtcp_engine_link
+{
+        microtcp_ring_t tx;            /* Data to send, moved into the retransmission queue by the engine */
+        microtcp_ring_t rx;            /* Data received in order, moved out of recvbuf by the engine */
+        microtcp_sock_t *socket;       /* Only touched by the engine until detached is set */
+        microtcp_listener_t *listener; /* Listener of the connection when it was attached, NULL for a client */
+        int event_fd;                  /* eventfd the engine writes while the application waits on it */
+        _Atomic bool app_waiting;      /* Application: it waits on event_fd */
+        _Atomic bool detach;           /* Application: it wants the connection back */
+        _Atomic bool peer_closed;      /* Engine: everything before the peer's FIN is in rx */
+        _Atomic bool detached;         /* Engine: it no longer touches the connection */
+};
+
+/* Start of declarations of inner working (helper) functions: */
+
+/**
+ * @deprecated
+ */
+static void create_microtcp_bit_stream_segment(microtcp_sock_t *const socket, const microtcp_segment_t *const __segment, void **__bit_stream, size_t *__stream_len);
+
+/**
+ * @deprecated
+ */
+static inline void init_microtcp_segment(microtcp_segment_t *const __segment, uint32_t __seq_num, uint32_t __ack_num,
+                                         uint16_t __ctrl_bits, uint16_t __win_size, uint32_t __data_len, uint8_t *__payload);
+
+/**
+ * @brief Creates a MicroTCP bitstream, containing a header and (optionally) payload, in a buffer of the socket's pool
+ * @param socket MicroTCP socket
+ * @param control control bits
+ * @param payload payload, set NULL if no payload
+ * @param payload_len payload size in bytes, at most MICROTCP_MSS
+ * @param stream_len is set to the size of the bitstream after successful creation
+ * @returns the created bitstream
+ */
+static void *create_bitstream(microtcp_sock_t *const socket, uint16_t control, const void *const payload, size_t payload_len, size_t *stream_len);
+
+/**
+ * @brief Extracts a MicroTCP bitstream without copying its payload and verifies its checksum
+ * @param socket MicroTCP socket that received the bitstream, selects the checksum algorithm
+ * @param bitstream bitstream to extract
+ * @param stream_len size of the bitstream in bytes
+ * @param segment is set to the header of the bitstream, its payload points into the bitstream (NULL if there is none)
+ * @returns 0 on success, -1 if the bitstream is shorter than its header says or its checksum does not match
+ */
+static int extract_bitstream(microtcp_sock_t *const socket, const void *const bitstream, size_t stream_len, microtcp_segment_t *const segment);
+
+/**
+ * @brief Builds a segment and sends it to the connected peer, piggybacking the current ACK number and window
+ * @param socket MicroTCP socket
+ * @param seq_number sequence number of the segment
+ * @param control control bits
+ * @param payload payload, set NULL if no payload
+ * @param payload_len payload size in bytes, at most MICROTCP_MSS
+ * @returns 0 on success, -1 on failure
+ */
+static int send_segment(microtcp_sock_t *const socket, uint32_t seq_number, uint16_t control, const void *const payload, size_t payload_len);
+
+/**
+ * @brief Sends a segment like send_segment(), given the checksum of its payload. The header and the payload are
+ *        handed to the kernel as two separate buffers, the payload is not copied.
+ * @param socket MicroTCP socket
+ * @param seq_number sequence number of the segment
+ * @param control control bits
+ * @param payload payload, set NULL if no payload
+ * @param payload_len payload size in bytes, at most MICROTCP_MSS
+ * @param payload_crc checksum register after the payload, starting from 0xffffffff
+ * @returns 0 on success, -1 on failure
+ */
+static int send_segment_checksummed(microtcp_sock_t *const socket, uint32_t seq_number, uint16_t control, const void *const payload, size_t payload_len,
+                                    uint32_t payload_crc);
+
+/**
+ * @brief Hands the segments of the transmit batch to the kernel, with as few sendmmsg() calls as possible
+ * @param socket MicroTCP socket
+ * @returns 0 on success, -1 if some segments could not be sent, which are dropped
+ */
+static int tx_flush(microtcp_sock_t *const socket);
+
+/**
+ * @brief Sends the transmit batch as runs of full-sized segments with UDP GSO. GSO is disabled on the
+ * socket if the kernel rejects a run.
+ * @param socket MicroTCP socket, with gso_enabled set
+ * @returns the number of segments sent, the rest of the batch is left to plain sendmmsg()
+ */
+static size_t tx_flush_gso(microtcp_sock_t *const socket);
+
+/**
+ * @brief Allocates the segment buffer pool and the transmit and receive batches of a connection, and
+ * clears gso_enabled if the kernel does not support UDP GSO
+ * @param socket MicroTCP socket
+ * @returns 0 on success, -1 on failure
+ */
+static int connection_buffers_init(microtcp_sock_t *const socket);
+
+/**
+ * @brief Releases what connection_buffers_init() allocated, datagrams still batched are dropped
+ * @param socket MicroTCP socket
+ */
+static void connection_buffers_free(microtcp_sock_t *const socket);
+
+/**
+ * @brief Allocates a receive batch, its buffers taken from a pool
+ * @param pool pool the buffers are taken from, unless GRO is used
+ * @param gro whether the batch receives datagrams coalesced by UDP GRO
+ * @returns the batch, NULL on failure
+ */
+static struct microtcp_rx_batch *rx_batch_create(microtcp_pool_t *pool, bool gro);
+
+/**
+ * @brief Releases a receive batch and returns its buffers to their pool
+ * @param batch batch returned by rx_batch_create(), NULL is ignored
+ * @param pool pool the batch was created from
+ */
+static void rx_batch_destroy(struct microtcp_rx_batch *batch, microtcp_pool_t *pool);
+
+/**
+ * @brief Refills the receive batch of a socket that has a UDP socket of its own with a single recvmmsg()
+ * @param socket MicroTCP socket, its receive batch processed
+ * @param flags MSG_DONTWAIT not to block
+ * @returns 0 on success, -1 if nothing was received
+ */
+static int rx_batch_receive(microtcp_sock_t *const socket, int flags);
+
+/**
+ * @brief Receives the datagrams that have arrived on the UDP socket of a listener with a single recvmmsg()
+ * and routes them: datagrams of the calling connection are copied to its receive batch, those of the other
+ * connections are processed right away, SYNs of new peers are put in the backlog and anything else is dropped.
+ * @param listener listener
+ * @param caller connection the application is blocked on, NULL if none
+ * @param flags MSG_DONTWAIT not to block
+ * @returns 0 on success, -1 if nothing was received
+ */
+static int listener_receive(microtcp_listener_t *const listener, microtcp_sock_t *const caller, int flags);
+
+/**
+ * @brief Sends the delayed ACKs of the connections of a listener whose timers have expired
+ * @param listener listener
+ * @param now current time in microseconds
+ * @returns the earliest delayed ACK deadline still pending, 0 if there is none
+ */
+static uint64_t listener_delack_timers(microtcp_listener_t *const listener, uint64_t now);
+
+/**
+ * @brief Processes a segment of an established connection outside of the loops of a blocking microtcp_send()
+ * or microtcp_recv(): its data is stored in the receive buffer, a FIN is noted for the next microtcp_recv()
+ * and the ACKs of data in flight are processed
+ * @param socket MicroTCP socket
+ * @param header header of the segment
+ * @param payload payload of the segment
+ */
+static void segment_input(microtcp_sock_t *const socket, const microtcp_header_t *const header, const uint8_t *const payload);
+
+/**
+ * @brief Validates the header of a received segment against the datagram carrying it
+ * @param socket MicroTCP socket the segment was received for, its loss counters are updated
+ * @param datagram the segment
+ * @param datagram_len length of the segment
+ * @param header is set to the header of the segment
+ * @returns 0 if the header is valid, -1 otherwise
+ */
+static int parse_segment(microtcp_sock_t *const socket, const uint8_t *datagram, size_t datagram_len, microtcp_header_t *header);
+
+/**
+ * @brief Completes the handshake with a peer whose SYN was received, on the server side
+ * @param socket MicroTCP socket, its connection buffers set up
+ * @param syn_header header of the SYN
+ * @param address address of the peer
+ * @param address_len length of the address
+ * @returns 0 on success, -1 on failure or with WOULD_BLOCK while a non-blocking socket waits for the final ACK
+ */
+static int accept_handshake(microtcp_sock_t *const socket, const microtcp_header_t *syn_header, const struct sockaddr *address, socklen_t address_len);
+
+/**
+ * @brief Moves the 3-way handshake on, sending the SYN or SYN-ACK again when its timer expires and
+ * processing the segments that arrive, until the connection is established
+ * @param socket MicroTCP socket in SYN_SENT or SYN_RECEIVED state
+ * @param wait whether to wait for the segments, otherwise WOULD_BLOCK is returned once none is left
+ * @returns 0 once the connection is established, -1 on failure or with WOULD_BLOCK
+ */
+static int handshake_wait(microtcp_sock_t *const socket, bool wait);
+
+/**
+ * @brief Processes a segment received during the 3-way handshake
+ * @param socket MicroTCP socket in SYN_SENT or SYN_RECEIVED state
+ * @param header header of the segment, expected to be the SYN-ACK in SYN_SENT and the final ACK in SYN_RECEIVED
+ * @returns 1 if the connection is established, 0 if the segment was not the one expected, -1 on failure
+ */
+static int handshake_input(microtcp_sock_t *const socket, const microtcp_header_t *const header);
+
+/**
+ * @brief Fails a call that would have to wait on a non-blocking socket
+ * @returns -1, with WOULD_BLOCK and errno set to EAGAIN
+ */
+static int would_block(void);
+
+/**
+ * @brief Does the protocol work of a connection that is due, without waiting: the handshake is moved on,
+ * every segment that has arrived is processed, the retransmission and delayed ACK timers are fired
+ * and the window is sent
+ * @param socket MicroTCP socket
+ * @returns 0 on success, -1 on failure
+ */
+static int connection_progress(microtcp_sock_t *const socket);
+
+/**
+ * @brief Sleeps until a datagram arrives or protocol work of the connection is due, see microtcp_poll_timeout()
+ * @param socket MicroTCP socket
+ * @param timeout_us longest sleep in microseconds, -1 for none
+ * @returns 0 on success, -1 on failure
+ */
+static int connection_wait(microtcp_sock_t *const socket, long timeout_us);
+
+/**
+ * @brief Finds when protocol work of a connection is due without anything arriving, see microtcp_poll_timeout()
+ * @param socket MicroTCP socket
+ * @returns microseconds until then, 0 if received datagrams wait in the receive batch, -1 if no timer is armed
+ */
+static long connection_timeout(const microtcp_sock_t *const socket);
+
+/**
+ * @brief Finds the events of microtcp_poll() that are ready
+ * @param socket MicroTCP socket
+ * @returns the MICROTCP_POLL* events ready
+ */
+static int poll_events(const microtcp_sock_t *const socket);
+
+/**
+ * @brief Hands data of the receive buffer to the application, and opens the window to the peer
+ * @param socket MicroTCP socket with data in recvbuf
+ * @param buffer where the data is copied
+ * @param length length of buffer
+ * @returns bytes copied
+ */
+static size_t recvbuf_deliver(microtcp_sock_t *const socket, uint8_t *buffer, size_t length);
+
+/**
+ * @brief Runs an engine: does the protocol work of its connections in turn, and sleeps once none is left
+ * until a datagram arrives, a timer is due or an application thread wakes it up
+ * @param arg the engine
+ * @returns NULL
+ */
+static void *engine_main(void *arg);
+
+/**
+ * @brief Does the protocol work of a connection of an engine: moves data from the send ring into the
+ * retransmission queue, processes what has arrived, fires the timers and moves data to the receive ring
+ * @param link connection of the engine, not detached
+ */
+static void engine_connection_run(struct microtcp_engine_link *const link);
+
+/**
+ * @brief Finds how long the engine may sleep
+ * @param engine engine
+ * @returns 0 if a connection has work that does not wait for anything, otherwise microseconds until
+ * the first timer of the connections is due, -1 if none is armed
+ */
+static long engine_timeout(microtcp_engine_t *const engine);
+
+/**
+ * @brief Wakes the engine up if it sleeps, after an application thread has given it work
+ * @param engine engine
+ */
+static void engine_wake(microtcp_engine_t *const engine);
+
+/**
+ * @brief Wakes the application thread up if it waits on the connection, after the engine has made progress on it
+ * @param link connection of the engine
+ */
+static void engine_notify(struct microtcp_engine_link *const link);
+
+/**
+ * @brief Finds the events of a connection of an engine that are ready, from its rings and flags alone
+ * @param link connection of the engine
+ * @returns the MICROTCP_POLL* events ready, or ENGINE_DETACHED
+ */
+static int engine_link_events(struct microtcp_engine_link *const link);
+
+/**
+ * @brief Blocks the application thread until one of the events of a connection of an engine is ready
+ * @param link connection of the engine
+ * @param events MICROTCP_POLL* events, ENGINE_DETACHED is always included
+ * @param timeout_us longest wait in microseconds, 0 not to wait and -1 for none
+ * @returns the events ready, 0 on timeout
+ */
+static int engine_link_wait(struct microtcp_engine_link *const link, int events, long timeout_us);
+
+/**
+ * @brief Copies data the engine has received into the application's buffer, waiting for it unless the socket is non-blocking
+ * @param socket MicroTCP socket with an engine link
+ * @param buffer where the data is copied
+ * @param length length of buffer
+ * @returns bytes copied, 0 once the receive ring is empty and the engine has let go of the connection, -1 on failure or with WOULD_BLOCK
+ */
+static ssize_t engine_recv(microtcp_sock_t *const socket, uint8_t *buffer, size_t length);
+
+/**
+ * @brief Releases the rings and eventfd of a connection of an engine
+ * @param link connection of the engine, NULL is ignored
+ */
+static void engine_link_free(struct microtcp_engine_link *link);
+
+/**
+ * @brief Turns UDP GRO on or off for the UDP socket
+ * @param socket MicroTCP socket, gro_enabled is cleared if the kernel does not support GRO
+ * @param on whether the kernel should coalesce received datagrams
+ */
+static void udp_gro_set(microtcp_sock_t *const socket, bool on);
+
+/**
+ * @brief Hands out the next received segment and validates its header. Once the receive batch
+ * has been processed, it is refilled with as many datagrams as a single recvmmsg() returns.
+ * Datagrams coalesced by UDP GRO are split into their segments in place.
+ * @param socket MicroTCP socket
+ * @param datagram is set to the segment, the payload follows the header. It stays valid until the next call.
+ * @param header is set to the header of the received segment
+ * @param flags MSG_DONTWAIT not to block, the transmit batch is flushed first unless it is set
+ * @returns 0 on success, -1 if no valid segment was received
+ */
+static int receive_segment(microtcp_sock_t *const socket, uint8_t **datagram, microtcp_header_t *header, int flags);
+
+/**
+ * @brief Checks whether received datagrams are waiting in the receive batch
+ * @param socket MicroTCP socket
+ * @returns true if receive_segment() will return without a system call
+ */
+static inline bool rx_batch_pending(const microtcp_sock_t *const socket);
+
+/**
+ * @brief Flushes the transmit batch and waits until a datagram is available on the socket or in the receive batch
+ * @param socket MicroTCP socket
+ * @param timeout_us timeout in microseconds
+ * @returns 1 if a datagram is available, 0 on timeout, -1 on failure
+ */
+static int wait_for_segment(microtcp_sock_t *const socket, long timeout_us);
+
+/**
+ * @brief Verifies the checksum of a data segment while storing its payload in the receive buffer, and acknowledges it
+ * @param socket MicroTCP socket
+ * @param header header of the received data segment
+ * @param payload payload of the received data segment
+ * @returns true if the segment is intact, false if its checksum does not match and it was dropped
+ */
+static bool receive_data(microtcp_sock_t *const socket, const microtcp_header_t *const header, const uint8_t *const payload);
+
+/**
+ * @brief Sends the pending delayed ACK if its timer has expired
+ * @param socket MicroTCP socket
+ * @param now current time in microseconds
+ */
+static void delack_timer(microtcp_sock_t *const socket, uint64_t now);
+
+/**
+ * @brief Allocates the retransmission queue of a connection
+ * @param queue retransmission queue
+ * @param iss sequence number of the first byte that will be queued
+ * @returns 0 on success, -1 on failure
+ */
+static int rtx_queue_init(microtcp_rtx_queue_t *const queue, uint32_t iss);
+
+static void rtx_queue_free(microtcp_rtx_queue_t *const queue);
+
+/**
+ * @brief Copies as much of the buffer as there is room for into the retransmission queue, computing the checksum of each segment in the same pass
+ * @param queue retransmission queue
+ * @param mode checksum algorithm of the connection
+ * @param buffer data to queue
+ * @param length size of the data in bytes
+ * @returns bytes queued
+ */
+static size_t rtx_queue_append(microtcp_rtx_queue_t *const queue, microtcp_checksum_t mode, const uint8_t *buffer, size_t length);
+
+/**
+ * @brief Converts an ACK number into a stream offset of the retransmission queue
+ * @param queue retransmission queue
+ * @param ack_number received ACK number
+ * @param offset is set to the stream offset of the ACK number
+ * @returns true if the ACK number acknowledges sent data, false if it is stale or invalid
+ */
+static bool rtx_queue_ack_offset(const microtcp_rtx_queue_t *const queue, uint32_t ack_number, uint64_t *offset);
+
+static inline size_t rtx_queue_index(uint64_t offset)
+{
+        return (offset / MICROTCP_MSS) & (MICROTCP_RTX_QUEUE_SLOTS - 1);
+}
+
+static inline microtcp_rtx_segment_t *rtx_queue_slot(const microtcp_rtx_queue_t *const queue, uint64_t offset)
+{
+        return &queue->segments[rtx_queue_index(offset)];
+}
+
+static inline uint8_t *rtx_queue_payload(const microtcp_rtx_queue_t *const queue, uint64_t offset)
+{
+        return queue->data + rtx_queue_index(offset) * MICROTCP_MSS + offset % MICROTCP_MSS;
+}
+
+/**
+ * @brief Sends queued data starting at the given offset, up to the end of the slot holding it
+ * @param socket MicroTCP socket
+ * @param offset stream offset of the first byte to send
+ * @param max_len maximum payload size in bytes
+ * @returns bytes sent, -1 on failure
+ */
+static ssize_t transmit_from_queue(microtcp_sock_t *const socket, uint64_t offset, size_t max_len);
+
+/**
+ * @brief Sends new queued data while the window, min(cwnd, peer window), allows it
+ * @param socket MicroTCP socket
+ * @returns 0 on success, -1 on failure
+ */
+static int transmit_window(microtcp_sock_t *const socket);
+
+/**
+ * @brief Processes the acknowledgement carried by a received segment
+ * @param socket MicroTCP socket
+ * @param header header of the received segment
+ */
+static void process_ack(microtcp_sock_t *const socket, const microtcp_header_t *const header);
+
+/**
+ * @brief Computes the pacing rate: the congestion controller's rate, or cwnd per SRTT with some headroom, capped by max_pacing_rate
+ * @param socket MicroTCP socket
+ * @returns the rate in bytes per second, 0 if transmissions are not paced
+ */
+static uint64_t pacing_rate(const microtcp_sock_t *const socket);
+
+/**
+ * @brief Refills the pacing token bucket and takes the tokens of a segment if there are enough
+ * @param socket MicroTCP socket
+ * @param segment_len size of the segment on the wire, header included
+ * @returns true if the segment may be sent now, false if it has to wait until pacing_next_us
+ */
+static bool pacing_take(microtcp_sock_t *const socket, size_t segment_len);
+
+/**
+ * @brief Feeds a round-trip time sample to the Jacobson/Karels estimator and recomputes the RTO
+ * @param socket MicroTCP socket
+ * @param rtt_us round-trip time sample in microseconds
+ */
+static void rtt_sample(microtcp_sock_t *const socket, uint64_t rtt_us);
+
+/**
+ * @brief Handles the expiry of the retransmission timer, backing off the RTO
+ * @param socket MicroTCP socket
+ */
+static void retransmission_timeout(microtcp_sock_t *const socket);
+
+/**
+ * @brief Fills the SACK blocks of an outgoing ACK with the out-of-order ranges held in recvbuf, and their shift
+ * in its control field
+ * @param socket MicroTCP socket
+ * @param header header of the outgoing segment, its ack_number must be set
+ */
+static void sack_encode(const microtcp_sock_t *const socket, microtcp_header_t *const header);
+
+/**
+ * @brief Marks the segments covered by the SACK blocks of a received ACK on the scoreboard
+ * @param socket MicroTCP socket
+ * @param header header of the received segment
+ */
+static void sack_update_scoreboard(microtcp_sock_t *const socket, const microtcp_header_t *const header);
+
+/**
+ * @brief Retransmits the next segment below the highest SACKed byte that the peer has not received
+ * @param socket MicroTCP socket
+ */
+static void sack_retransmit_hole(microtcp_sock_t *const socket);
+
+/**
+ * @brief Copies data into the recvbuf ring, computing its checksum in the same pass
+ * @param socket MicroTCP socket
+ * @param position distance from the next byte to be delivered to the application
+ * @param data data to copy
+ * @param len size of the data in bytes
+ * @param crc checksum register before the data
+ * @returns the checksum register after the data
+ */
+static uint32_t recvbuf_write(microtcp_sock_t *const socket, size_t position, const uint8_t *data, size_t len, uint32_t crc);
+
+/**
+ * @brief Moves in-order data out of the recvbuf ring
+ * @param socket MicroTCP socket
+ * @param buffer destination of the data
+ * @param len bytes to move, at most buf_fill_level
+ */
+static void recvbuf_read(microtcp_sock_t *const socket, uint8_t *buffer, size_t len);
+
+/**
+ * @brief Records that [start, end) is held in recvbuf, merging it with the ranges it touches
+ * @param socket MicroTCP socket
+ * @param start first sequence number of the range
+ * @param end sequence number past the range
+ * @returns true if the range was recorded, false if there is no room to track it
+ */
+static bool ooo_range_insert(microtcp_sock_t *const socket, uint32_t start, uint32_t end);
+
+/**
+ * @brief Times how long the peer takes to fill the offered window, an upper bound of the RTT that needs no help from the sender
+ * @param socket MicroTCP socket
+ */
+static void rcv_rtt_measure(microtcp_sock_t *const socket);
+
+/**
+ * @brief Once per receiver RTT, sizes recvbuf to twice what the application drained during it, within the configured bounds
+ * @param socket MicroTCP socket
+ * @param bytes_read bytes the application has just read
+ */
+static void recvbuf_autotune(microtcp_sock_t *const socket, size_t bytes_read);
+
+/**
+ * @brief Resizes recvbuf in place, in-order and out-of-order data alike are kept
+ * @param socket MicroTCP socket
+ * @param len new size of recvbuf, large enough for everything it holds and at most recvbuf_reserved
+ */
+static void recvbuf_resize(microtcp_sock_t *const socket, size_t len);
+
+/**
+ * @brief Maps the address space recvbuf may grow to, so that auto-tuning never allocates,
+ * memory is only backed by pages once the ring reaches it
+ * @param socket MicroTCP socket, recvbuf_max_len bytes are mapped
+ * @returns 0 on success, -1 on failure
+ */
+static int recvbuf_reserve(microtcp_sock_t *const socket);
+
+/**
+ * @brief Unmaps recvbuf
+ * @param socket MicroTCP socket
+ */
+static void recvbuf_release(microtcp_sock_t *const socket);
+
+/** @returns the smallest shift that fits a window of recvbuf_len bytes in the 16-bit header field */
+static inline uint8_t window_shift(size_t recvbuf_len)
+{
+        uint8_t shift = 0;
+        while (shift < MICROTCP_MAX_WSCALE && (recvbuf_len >> shift) > UINT16_MAX)
+                shift++;
+        return shift;
+}
+
+/** @returns true if recvbuf_min_len <= recvbuf_len <= recvbuf_max_len are valid sizes of recvbuf */
+static inline bool recvbuf_bounds_valid(const microtcp_sock_t *const socket)
+{
+        return socket->recvbuf_min_len >= MICROTCP_MSS && socket->recvbuf_min_len <= socket->recvbuf_len &&
+               socket->recvbuf_len <= socket->recvbuf_max_len && socket->recvbuf_max_len <= MICROTCP_MAX_RECVBUF_LEN;
+}
+
+/** @returns the SYN options requested by this end of the connection */
+static inline uint32_t requested_options(const microtcp_sock_t *const socket)
+{
+        /* The shift is fixed for the whole connection, so it must fit the largest buffer auto-tuning may grow to. */
+        uint32_t options = MICROTCP_OPT_WSCALE | ((uint32_t) window_shift(socket->recvbuf_max_len) << MICROTCP_OPT_WSCALE_OFFSET);
+        options |= (uint32_t) socket->checksum << MICROTCP_OPT_CHECKSUM_OFFSET;
+        return socket->sack_enabled ? (options | MICROTCP_OPT_SACK) : options;
+}
+
+/** @returns the SYN options in effect after the 3-way handshake */
+static inline uint32_t negotiated_options(const microtcp_sock_t *const socket)
+{
+        uint32_t options = socket->sack_permitted ? MICROTCP_OPT_SACK : 0;
+        options |= (uint32_t) socket->checksum_mode << MICROTCP_OPT_CHECKSUM_OFFSET;
+        if (socket->rcv_wscale != 0 || socket->snd_wscale != 0)
+                options |= MICROTCP_OPT_WSCALE | ((uint32_t) socket->rcv_wscale << MICROTCP_OPT_WSCALE_OFFSET);
+        return options;
+}
+
+/**
+ * @brief Applies the window scaling options of the peer's SYN or SYN-ACK, scaling is in effect only if both ends asked for it
+ * @param socket MicroTCP socket
+ * @param options future_use0 of the peer's SYN or SYN-ACK
+ */
+static inline void negotiate_window_scale(microtcp_sock_t *const socket, uint32_t options)
+{
+        bool wscale = (options & MICROTCP_OPT_WSCALE) != 0;
+        uint8_t peer_shift = (options >> MICROTCP_OPT_WSCALE_OFFSET) & 0xff;
+
+        socket->rcv_wscale = wscale ? window_shift(socket->recvbuf_max_len) : 0;
+        socket->snd_wscale = (!wscale) ? 0 : (peer_shift < MICROTCP_MAX_WSCALE) ? peer_shift : MICROTCP_MAX_WSCALE;
+}
+
+/**
+ * @brief Applies the checksum option of the peer's SYN or SYN-ACK, the algorithm asked for by both ends or CRC-32
+ * @param socket MicroTCP socket
+ * @param options future_use0 of the peer's SYN or SYN-ACK
+ */
+static inline void negotiate_checksum(microtcp_sock_t *const socket, uint32_t options)
+{
+        uint8_t peer_checksum = (options >> MICROTCP_OPT_CHECKSUM_OFFSET) & 0xff;
+
+        socket->checksum_mode = (peer_checksum == socket->checksum && peer_checksum <= MICROTCP_CHECKSUM_NONE) ? socket->checksum : MICROTCP_CHECKSUM_CRC32;
+}
+
+/** @returns the value of the header window field advertising window bytes, windows of SYN segments are never scaled */
+static inline uint16_t window_field(const microtcp_sock_t *const socket, size_t window, uint16_t control)
+{
+        if (!(control & SYN_BIT))
+                window >>= socket->rcv_wscale;
+        return (window > UINT16_MAX) ? UINT16_MAX : window;
+}
+
+/** @returns the checksum algorithm of a segment, SYN segments carry a CRC-32 as the algorithm is negotiated by them */
+static inline microtcp_checksum_t segment_checksum_mode(const microtcp_sock_t *const socket, uint16_t control)
+{
+        return (control & SYN_BIT) ? MICROTCP_CHECKSUM_CRC32 : socket->checksum_mode;
+}
+
+/** @returns the checksum register after data, which is also copied to dst unless dst is NULL */
+static inline uint32_t checksum_pass(microtcp_checksum_t mode, uint32_t crc, uint8_t *dst, const uint8_t *data, size_t len)
+{
+        switch (mode)
+        {
+        case MICROTCP_CHECKSUM_CRC32:
+                return (dst != NULL) ? update_crc32_copy(crc, dst, data, len) : update_crc32_fast(crc, data, len);
+        case MICROTCP_CHECKSUM_CRC32C:
+                return crc32c_pass(crc, dst, data, len);
+        default:
+                if (dst != NULL && len > 0)
+                        memcpy(dst, data, len);
+                return crc;
+        }
+}
+
+/** @returns the value of the checksum field for the final checksum register, 0 if segments are not checksummed */
+static inline uint32_t checksum_final(microtcp_checksum_t mode, uint32_t crc)
+{
+        return (mode == MICROTCP_CHECKSUM_NONE) ? 0 : crc ^ 0xffffffff;
+}
+
+/** @returns the checksum register after the header of a segment, its checksum field taken as zero, which follows the payload */
+static inline uint32_t header_crc(microtcp_checksum_t mode, uint32_t payload_crc, const microtcp_header_t *const header)
+{
+        microtcp_header_t zeroed = *header;
+        zeroed.checksum = 0;
+        return checksum_pass(mode, payload_crc, NULL, (const uint8_t *) &zeroed, sizeof(microtcp_header_t));
+}
+
+/**
+ * @returns the checksum of a segment, over its payload and then its header with a zero checksum field. The payload
+ * comes first so that the part of queued data is computed once, although the header changes on every transmission.
+ */
+static inline uint32_t segment_checksum(microtcp_checksum_t mode, const microtcp_header_t *const header, const uint8_t *const payload, size_t payload_len)
+{
+        return checksum_final(mode, header_crc(mode, checksum_pass(mode, 0xffffffff, NULL, payload, payload_len), header));
+}
+
+static inline uint64_t now_us(void)
+{
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static inline struct sockaddr *peer_address(const microtcp_sock_t *const socket)
+{
+        return (socket->cliaddr == NULL) ? socket->servaddr : socket->cliaddr;
+}
+
+static int server_shutdown(microtcp_sock_t *socket);
+
+/**
+ * @brief Acknowledges the FIN of the peer and sends a FIN of its own, on the server side. The connection
+ * waits for the final ACK in CLOSING_BY_PEER state, sending the FIN again on timeout.
+ * @param socket MicroTCP socket whose peer has finished sending
+ */
+static void passive_close_start(microtcp_sock_t *const socket);
+
+/**
+ * @brief Takes in a segment that arrived for a connection in CLOSING_BY_PEER state: the final ACK, or a
+ * retransmitted FIN of the peer, which is answered with the FIN-ACK again
+ * @param socket MicroTCP socket in CLOSING_BY_PEER state
+ * @param header header of the segment
+ */
+static void passive_close_input(microtcp_sock_t *const socket, const microtcp_header_t *const header);
+
+/**
+ * @brief Closes a connection once the final ACK of the peer has arrived or is no longer waited for,
+ * and releases its buffers
+ * @param socket MicroTCP socket in CLOSING_BY_PEER state
+ */
+static void passive_close_finish(microtcp_sock_t *const socket);
+
+/**
+ * @brief Takes in what has arrived for a connection in CLOSING_BY_PEER state without blocking, and closes it
+ * once the final ACK is in or no longer waited for
+ * @param socket MicroTCP socket in CLOSING_BY_PEER state
+ * @returns true if the connection has been closed
+ */
+static bool passive_close_progress(microtcp_sock_t *const socket);
+
+/**
+ * @brief Sends the FIN on the client side, once the data in flight has been acknowledged. The connection
+ * waits for the ACK and the FIN-ACK of the peer in CLOSING_BY_HOST state.
+ * @param socket MicroTCP socket in ESTABLISHED state
+ * @returns 0 on success, -1 on failure
+ */
+static int active_close_start(microtcp_sock_t *const socket);
+
+/**
+ * @brief Moves on the close of a connection in CLOSING_BY_HOST state: the FIN is sent again on timeout,
+ * with backoff, and the final ACK once the FIN-ACK of the peer arrives
+ * @param socket MicroTCP socket in CLOSING_BY_HOST state
+ * @param wait whether to wait for the peer, or to fail with WOULD_BLOCK when nothing has arrived
+ * @returns 0 once the connection is closed, -1 on failure or when it would block. It is closed anyway
+ * when the peer does not finish closing in time.
+ */
+static int active_close_progress(microtcp_sock_t *const socket, bool wait);
+
+/**
+ * @brief Closes a connection on the client side and releases its buffers
+ * @param socket MicroTCP socket in CLOSING_BY_HOST state
+ */
+static void active_close_finish(microtcp_sock_t *const socket);
+
+/* REMOVE BEFORE SUBMISSION. */
+static void print_bitstream(void *stream, size_t length)
+{
+        char *str = stream;
+        for (size_t i = 0; i < length; i++)
+                printf("%d | ", str[i]);
+        printf("\n");
+}
+
+/* End   of declarations of inner working (helper) functions. */
+
+microtcp_sock_t microtcp_socket(int domain, int type, int protocol)
+{
+        microtcp_sock_t micro_sock;
+
+        micro_sock.state = READY;
+        if (domain != AF_INET)
+        {
+                fprintf(stderr, "Warning: MicroTCP only accepts AF_INET (IPv4) as its socket domain parameter.\n");
+                micro_sock.state = WARNING;
+        }
+        if (type != SOCK_DGRAM || (protocol != 0 && protocol != IPPROTO_UDP))
+        {
+                fprintf(stderr, "Warning: MicroTCP only accepts UDP protocol as its backbone.\n");
+                micro_sock.state = WARNING;
+        }
+        if ((micro_sock.sd = socket(domain, type, protocol)) < 0)
+        {
+                fprintf(stderr, "Error: Unable to create socket for MicroTCP.\n");
+                micro_sock.state = INVALID;
+        }
+
+        /* Default initializations: */
+        micro_sock.init_win_size = MICROTCP_WIN_SIZE;
+        micro_sock.peer_win_size = MICROTCP_WIN_SIZE;
+
+        micro_sock.curr_win_size = MICROTCP_INIT_CWND; /* TODO: Should these two be the same? */
+        micro_sock.cc_ops = &microtcp_cc_reno;
+        micro_sock.cc_ops->init(&micro_sock);
+
+        micro_sock.recvbuf = NULL;
+        micro_sock.buf_fill_level = 0;
+        micro_sock.recvbuf_head = 0;
+        micro_sock.recvbuf_len = MICROTCP_RECVBUF_LEN;
+        micro_sock.recvbuf_min_len = MICROTCP_RECVBUF_LEN;
+        micro_sock.recvbuf_max_len = MICROTCP_RECVBUF_AUTOTUNE_MAX;
+        micro_sock.recvbuf_reserved = 0;
+        micro_sock.rcv_rtt_us = 0;
+        micro_sock.rcv_rtt_seq = 0;
+        micro_sock.rcv_rtt_start_us = 0;
+        micro_sock.drained_bytes = 0;
+        micro_sock.drain_start_us = 0;
+        micro_sock.shrink_target = 0;
+        micro_sock.shrink_rtts = 0;
+        micro_sock.rcv_wscale = 0;
+        micro_sock.snd_wscale = 0;
+        micro_sock.checksum = MICROTCP_CHECKSUM_CRC32;
+        micro_sock.checksum_mode = MICROTCP_CHECKSUM_CRC32;
+        micro_sock.rtx_queue.segments = NULL;
+        micro_sock.rtx_queue.data = NULL;
+        micro_sock.pool.slots = NULL;
+        micro_sock.pool.free_mask = 0;
+        micro_sock.tx_batch = NULL;
+        micro_sock.gso_enabled = false;
+        micro_sock.gro_enabled = false;
+        micro_sock.listener = NULL;
+        micro_sock.nonblocking = false;
+        micro_sock.handshake_deadline_us = 0;
+        micro_sock.fin_acked = false;
+        micro_sock.fin_retransmissions = 0;
+        micro_sock.engine = NULL;
+        micro_sock.engine_link = NULL;
+        micro_sock.rx_batch = NULL;
+        micro_sock.srtt_us = 0;
+        micro_sock.rttvar_us = 0;
+        micro_sock.rto_us = MICROTCP_ACK_TIMEOUT_US;
+        micro_sock.rto_min_us = MICROTCP_MIN_RTO_US;
+        micro_sock.rto_max_us = MICROTCP_MAX_RTO_US;
+        micro_sock.rto_deadline_us = 0;
+        micro_sock.pacing_enabled = true;
+        micro_sock.max_pacing_rate = 0;
+        micro_sock.pacing_rate = 0;
+        micro_sock.pacing_tokens = MICROTCP_PACING_BURST;
+        micro_sock.pacing_last_us = 0;
+        micro_sock.pacing_next_us = 0;
+        micro_sock.dup_acks = 0;
+        micro_sock.in_recovery = false;
+        micro_sock.recover = 0;
+        micro_sock.sack_enabled = true;
+        micro_sock.sack_permitted = false;
+        micro_sock.sack_high = 0;
+        micro_sock.sack_rtx_next = 0;
+        micro_sock.ack_every = MICROTCP_ACK_EVERY;
+        micro_sock.delack_timeout_us = MICROTCP_DELACK_TIMEOUT_US;
+        micro_sock.segments_unacked = 0;
+        micro_sock.delack_deadline_us = 0;
+        micro_sock.advertised_win = 0;
+        micro_sock.fin_received = false;
+        micro_sock.ooo_count = 0;
+        micro_sock.ooo_last = 0;
+        micro_sock.seq_number = rand() | 0b1; /* Random number not zero. */
+        micro_sock.ack_number = 0;            /* Undefined. */
+        micro_sock.packets_send = 0;
+        micro_sock.packets_received = 0;
+        micro_sock.packets_lost = 0;
+        micro_sock.bytes_send = 0;
+        micro_sock.bytes_received = 0;
+        micro_sock.bytes_lost = 0;
+        micro_sock.checksum_failures = 0;
+        micro_sock.tx_syscalls = 0;
+        micro_sock.rx_syscalls = 0;
+
+        micro_sock.servaddr = NULL;
+        micro_sock.cliaddr = NULL;
+
+        return micro_sock;
+}
+
+int microtcp_bind(microtcp_sock_t *socket, const struct sockaddr *address, socklen_t address_len)
+{
+        /* Essential check-ups. Reporting errors. */
+        if (socket == NULL || socket->sd < 0 || socket->state != READY)
+        {
+                if (socket == NULL)
+                        fprintf(stderr, "Error: microtcp_bind() failed, socket address was NULL.\n");
+                else if (socket->sd < 0)
+                        fprintf(stderr, "Error: File descriptor of MicroTCP socket was invalid.\n");
+                else if (socket->state != READY)
+                        fprintf(stderr, "Error: MicroTCP socket was not in a READY state.\n");
+                return -1;
+        }
+
+        /* Upon successful completion, bind() shall return 0; otherwise,
+         * -1 shall be returned and errno set to indicate the error.  */
+        int bind_ret_val = bind(socket->sd, address, address_len);
+        if (bind_ret_val == 0)          /* Thus bind() was successful. */
+                socket->state = LISTEN; /* Socket is ready for incoming connection. */
+        else                            /* Bind failed. */
+                fprintf(stderr, "Error: microtcp_bind() failed.\n");
+
+        socket->servaddr = malloc(address_len);
+        memcpy(socket->servaddr, address, address_len);
+
+        return bind_ret_val;
+}
+
+/* PHASE B TODO: compartmentalize functions even further.
+ *Inner loops will be need for packet loss management.
+ * */
+/** @return Upon successful completion, connect() shall return 0; otherwise, -1 . */
+int microtcp_connect(microtcp_sock_t *socket, const struct sockaddr *address, socklen_t address_len)
+{
+        /* A non-blocking connect is completed by calling it again, or by microtcp_poll(). */
+        if (socket != NULL && socket->state == SYN_SENT)
+                return handshake_wait(socket, !socket->nonblocking);
+
+        if (socket == NULL || socket->state != READY)
+        {
+                microtcp_set_errno(socket == NULL ? NULL_POINTER_ARGUMENT : SOCKET_STATE_NOT_READY);
+                return -1;
+        }
+        if (!recvbuf_bounds_valid(socket))
+        {
+                microtcp_set_errno(INVALID_RECVBUF_LEN);
+                return -1;
+        }
+        socket->curr_win_size = socket->recvbuf_len;
+        if (connection_buffers_init(socket) < 0)
+                return -1;
+
+        socket->servaddr = malloc(address_len);
+        memcpy(socket->servaddr, address, address_len);
+
+        if (recvbuf_reserve(socket) < 0)
+                return -1;
+        socket->buf_fill_level = 0;
+        socket->recvbuf_head = 0;
+        socket->init_win_size = socket->recvbuf_len;
+        socket->rcv_rtt_start_us = 0;
+        socket->drained_bytes = 0;
+        socket->drain_start_us = now_us();
+        socket->shrink_target = 0;
+        socket->shrink_rtts = 0;
+
+        /* The SYN goes out right away, and again whenever the SYN-ACK does not arrive in time. */
+        socket->state = SYN_SENT;
+        socket->handshake_deadline_us = 0;
+        return handshake_wait(socket, !socket->nonblocking);
+}
+
+int microtcp_accept(microtcp_sock_t *socket, struct sockaddr *address, socklen_t address_len)
+{
+        /* A non-blocking accept is completed by calling it again, or by microtcp_poll(). */
+        if (socket != NULL && socket->state == SYN_RECEIVED)
+                return handshake_wait(socket, !socket->nonblocking);
+
+        if (socket == NULL || socket->state != LISTEN)
+        {
+                if (socket == NULL)
+                        fprintf(stderr, "Error: microtcp_accept() failed, socket address was NULL.\n");
+                else
+                        fprintf(stderr, "Error: microtcp_accept() failed, as given socket was not in LISTEN state.\n");
+                return -1;
+        }
+        if (!recvbuf_bounds_valid(socket))
+        {
+                microtcp_set_errno(INVALID_RECVBUF_LEN);
+                return -1;
+        }
+
+        uint8_t datagram[MICROTCP_DATAGRAM_LEN];
+        microtcp_header_t syn_header;
+        ssize_t ret_val;
+
+        /* Wait for a SYN, ignoring anything else. A non-blocking socket sets nothing up before it arrives. */
+        do
+        {
+                ret_val = recvfrom(socket->sd, datagram, sizeof(datagram), socket->nonblocking ? MSG_DONTWAIT : NO_FLAGS_BITS, address, &address_len);
+                if (ret_val < 0 && socket->nonblocking && (errno == EAGAIN || errno == EWOULDBLOCK))
+                        return would_block();
+                if (ret_val < (ssize_t) sizeof(microtcp_header_t))
+                {
+                        microtcp_set_errno(ret_val < 0 ? RECVFROM_FAILED : RECVFROM_CORRUPTED);
+                        continue;
+                }
+                memcpy(&syn_header, datagram, sizeof(microtcp_header_t));
+                if (syn_header.checksum != segment_checksum(MICROTCP_CHECKSUM_CRC32, &syn_header, NULL, 0))
+                {
+                        microtcp_set_errno(CHECKSUM_MISMATCH);
+                        socket->checksum_failures++;
+                        continue;
+                }
+                if (syn_header.control != SYN_BIT)
+                {
+                        microtcp_set_errno(SYN_PACKET_EXPECTED);
+                        continue;
+                }
+                break;
+        } while (true);
+
+        if (connection_buffers_init(socket) < 0)
+                return -1;
+        return accept_handshake(socket, &syn_header, address, address_len);
+}
+
+int microtcp_listen(microtcp_listener_t *listener, const struct sockaddr *address, socklen_t address_len, size_t backlog)
+{
+        if (listener == NULL || address == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+        if (backlog == 0)
+        {
+                microtcp_set_errno(INVALID_ARGUMENT);
+                return -1;
+        }
+
+        listener->sd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (listener->sd < 0 || bind(listener->sd, address, address_len) < 0)
+        {
+                microtcp_set_errno(BIND_FAILED);
+                if (listener->sd >= 0)
+                        close(listener->sd);
+                return -1;
+        }
+
+        listener->backlog = malloc(backlog * sizeof(microtcp_pending_syn_t));
+        listener->backlog_len = backlog;
+        listener->backlog_head = 0;
+        listener->backlog_count = 0;
+        listener->rx_batch = NULL;
+        listener->rx_syscalls = 0;
+        listener->datagrams_dropped = 0;
+        listener->delack_deadline_us = 0;
+        listener->engine = NULL;
+        if (listener->backlog == NULL || microtcp_flow_init(&listener->flows, backlog) < 0 || microtcp_pool_init(&listener->pool) < 0 ||
+            (listener->rx_batch = rx_batch_create(&listener->pool, false)) == NULL)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                microtcp_listener_close(listener);
+                return -1;
+        }
+
+        /* The source of every datagram is needed to route it. */
+        for (size_t i = 0; i < MICROTCP_RX_BATCH; i++)
+                listener->rx_batch->messages[i].msg_hdr.msg_name = &listener->rx_batch->peers[i];
+
+        return 0;
+}
+
+int microtcp_listener_accept(microtcp_listener_t *listener, microtcp_sock_t *socket, struct sockaddr *address, socklen_t address_len)
+{
+        if (listener == NULL || socket == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+        /* The engine receives on the UDP socket for the connections it has, a new one would race with it. */
+        if (listener->engine != NULL && listener->engine->running)
+        {
+                microtcp_set_errno(ENGINE_RUNNING);
+                return -1;
+        }
+        /* A non-blocking accept is completed by calling it again, or by microtcp_poll(). */
+        if (socket->state == SYN_RECEIVED && socket->listener == listener)
+                return handshake_wait(socket, !socket->nonblocking);
+        if (socket->state != READY)
+        {
+                microtcp_set_errno(SOCKET_STATE_NOT_READY);
+                return -1;
+        }
+        if (!recvbuf_bounds_valid(socket))
+        {
+                microtcp_set_errno(INVALID_RECVBUF_LEN);
+                return -1;
+        }
+
+        /* Nothing is set up before a SYN is taken from the backlog, so that a non-blocking call can be repeated. */
+        while (listener->backlog_count == 0)
+        {
+                if (listener_receive(listener, NULL, socket->nonblocking ? MSG_DONTWAIT : NO_FLAGS_BITS) < 0)
+                        return socket->nonblocking ? would_block() : -1;
+        }
+        microtcp_pending_syn_t syn = listener->backlog[listener->backlog_head];
+        listener->backlog_head = (listener->backlog_head + 1) % listener->backlog_len;
+        listener->backlog_count--;
+
+        /* The connection sends through the listener's UDP socket, and only receives what is routed to it. */
+        if (socket->sd >= 0 && socket->sd != listener->sd)
+                close(socket->sd);
+        socket->sd = listener->sd;
+        socket->listener = listener;
+        socket->gro_enabled = false;
+        if (connection_buffers_init(socket) < 0)
+                return -1;
+
+        /* From now on the peer's datagrams, the final ACK of the handshake included, are routed to the connection. */
+        if (microtcp_flow_insert(&listener->flows, &syn.peer, socket) < 0)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                return -1;
+        }
+        if (address != NULL)
+                memcpy(address, &syn.peer, address_len < sizeof(syn.peer) ? address_len : sizeof(syn.peer));
+        if (accept_handshake(socket, &syn.header, (const struct sockaddr *) &syn.peer, sizeof(syn.peer)) < 0)
+        {
+                if (MICRO_ERRNO != WOULD_BLOCK)
+                        microtcp_flow_remove(&listener->flows, &syn.peer);
+                return -1;
+        }
+
+        return 0;
+}
+
+void microtcp_listener_close(microtcp_listener_t *listener)
+{
+        if (listener == NULL)
+                return;
+
+        rx_batch_destroy(listener->rx_batch, &listener->pool);
+        listener->rx_batch = NULL;
+        microtcp_pool_free(&listener->pool);
+        microtcp_flow_free(&listener->flows);
+        free(listener->backlog);
+        listener->backlog = NULL;
+        listener->backlog_count = 0;
+        if (listener->sd >= 0)
+                close(listener->sd);
+        listener->sd = -1;
+}
+
+int microtcp_set_congestion_control(microtcp_sock_t *socket, const char *name)
+{
+        if (socket == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+
+        const struct microtcp_cc_ops *cc_ops = microtcp_cc_find(name);
+        if (cc_ops == NULL)
+        {
+                microtcp_set_errno(UNKNOWN_CONGESTION_CONTROL);
+                return -1;
+        }
+
+        socket->cc_ops = cc_ops;
+        socket->cc_ops->init(socket);
+        socket->in_recovery = false;
+        socket->dup_acks = 0;
+
+        return 0;
+}
+
+int microtcp_shutdown(microtcp_sock_t *socket, int how)
+{
+        if (socket == NULL)
+        {
+                fprintf(stderr, "Error: microtcp_shutdown() failed, socket was NULL.\n");
+                return -1;
+        }
+        /* A non-blocking shutdown is completed by calling it again, or by microtcp_poll(). */
+        if (socket->state == CLOSING_BY_HOST)
+                return active_close_progress(socket, !socket->nonblocking);
+        if (socket->state != ESTABLISHED)
+        {
+                fprintf(stderr, "Error: microtcp_shutdown() failed, socket state was not ESTABLISHED.\n");
+                return -1;
+        }
+        if (socket->cliaddr != NULL)
+        {
+                fprintf(stderr, "Error: microtcp_shutdown() failed, shutdown cannot be called by the server.\n");
+                return -1;
+        }
+
+        /* The engine hands the connection back once the data of its send ring has been acknowledged. A
+         * non-blocking socket only asks for it, and is detached by a later call. */
+        if (socket->engine != NULL && socket->nonblocking && socket->engine->running &&
+            (engine_link_events(socket->engine_link) & ENGINE_DETACHED) == 0)
+        {
+                if (!atomic_exchange(&socket->engine_link->detach, true))
+                        engine_wake(socket->engine);
+                return would_block();
+        }
+        if (socket->engine != NULL && microtcp_engine_detach(socket) < 0)
+                return -1;
+
+        /* Data a non-blocking microtcp_send() left in flight is acknowledged before the FIN is sent. */
+        while (socket->rtx_queue.una < socket->rtx_queue.end)
+        {
+                if (connection_progress(socket) < 0)
+                        return -1;
+                if (socket->rtx_queue.una == socket->rtx_queue.end)
+                        break;
+                if (socket->nonblocking)
+                        return would_block();
+                if (connection_wait(socket, -1) < 0)
+                        return -1;
+        }
+
+        switch (how)
+        {
+        /* Block both */
+        default:
+                if (active_close_start(socket) < 0)
+                        return -1;
+                return active_close_progress(socket, !socket->nonblocking);
+
+        /* TODO: Phase B (probably?) */
+        /* Block recv */
+        case SHUT_RD:
+                break;
+
+        /* Block send */
+        case SHUT_WR:
+                break;
+        }
+
+        return 0;
+}
+
+ssize_t microtcp_send(microtcp_sock_t *socket, const void *buffer, size_t length, int flags)
+{
+        if (socket == NULL || buffer == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+        if (socket->state != ESTABLISHED)
+        {
+                microtcp_set_errno(SOCKET_STATE_NOT_ESTABLISHED);
+                return -1;
+        }
+
+        /* Sliding window sender. The buffer is copied into the retransmission queue as room frees up,
+         * and up to min(cwnd, peer window) bytes of the queue are kept in flight at any time. */
+        microtcp_rtx_queue_t *queue = &socket->rtx_queue;
+        const uint8_t *data = buffer;
+        size_t queued = 0;
+
+        /* With an engine, the data is only copied into the send ring, the engine does the rest. */
+        if (socket->engine != NULL)
+        {
+                struct microtcp_engine_link *link = socket->engine_link;
+                while (true)
+                {
+                        size_t written = microtcp_ring_write(&link->tx, data + queued, length - queued);
+                        queued += written;
+                        if (written > 0)
+                                engine_wake(socket->engine);
+                        if (queued == length)
+                                return queued;
+                        if (socket->nonblocking)
+                                return (queued > 0) ? (ssize_t) queued : would_block();
+                        engine_link_wait(link, MICROTCP_POLLOUT, -1);
+                }
+        }
+
+        /* Without blocking, only what fits in the queue is taken. It is acknowledged and retransmitted
+         * as the application keeps calling in, see microtcp_poll(). */
+        if (socket->nonblocking)
+        {
+                if (connection_progress(socket) < 0)
+                        return -1;
+                queued = rtx_queue_append(queue, socket->checksum_mode, data, length);
+                if (transmit_window(socket) < 0 || tx_flush(socket) < 0)
+                        return -1;
+                if (queued == 0 && length > 0)
+                        return would_block();
+                socket->seq_number = queue->iss + (uint32_t) queue->end;
+                socket->bytes_send += queued;
+                return queued;
+        }
+
+        uint8_t *datagram;
+        microtcp_header_t header;
+
+        while (queued < length || queue->una < queue->end)
+        {
+                queued += rtx_queue_append(queue, socket->checksum_mode, data + queued, length - queued);
+                /* Whatever the window allows goes to the kernel at once, before the timers are looked at. */
+                if (transmit_window(socket) < 0 || tx_flush(socket) < 0)
+                        return -1;
+
+                uint64_t now = now_us();
+                if (socket->rto_deadline_us != 0 && now >= socket->rto_deadline_us)
+                {
+                        retransmission_timeout(socket);
+                        continue;
+                }
+                delack_timer(socket, now);
+
+                /* Sleep until an ACK arrives, or the retransmission timer, pacing or a delayed ACK is due. */
+                uint64_t deadline = socket->rto_deadline_us;
+                if (socket->pacing_next_us != 0 && (deadline == 0 || socket->pacing_next_us < deadline))
+                        deadline = socket->pacing_next_us;
+                if (socket->delack_deadline_us != 0 && (deadline == 0 || socket->delack_deadline_us < deadline))
+                        deadline = socket->delack_deadline_us;
+                int ready = wait_for_segment(socket, deadline == 0 ? socket->rto_us : (deadline > now ? deadline - now : 0));
+                if (ready < 0)
+                        return -1;
+                if (ready == 0)
+                        continue;
+
+                /* Process every ACK that has already arrived, not just the first one. */
+                int recv_flags = NO_FLAGS_BITS;
+                while (receive_segment(socket, &datagram, &header, recv_flags) == 0)
+                {
+                        recv_flags = MSG_DONTWAIT;
+                        if (header.data_len > 0 && !receive_data(socket, &header, datagram + sizeof(microtcp_header_t)))
+                                continue;
+                        if ((header.control & ACK_BIT) == ACK_BIT)
+                                process_ack(socket, &header);
+                        /* Data of the batch is acknowledged once all of it has been processed. */
+                        if (!rx_batch_pending(socket))
+                                delack_timer(socket, now_us());
+                }
+
+                /* Retransmissions and ACKs are flushed before acknowledged slots can be refilled. */
+                if (tx_flush(socket) < 0)
+                        return -1;
+        }
+
+        socket->seq_number = queue->iss + (uint32_t) queue->end;
+        socket->bytes_send += length;
+
+        return length;
+}
+
+ssize_t microtcp_recv(microtcp_sock_t *socket, void *buffer, size_t length, int flags)
+{
+        if (socket == NULL || buffer == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+        /* An engine may have closed the connection while a non-blocking call waited for it to let go. */
+        if (socket->state != ESTABLISHED && socket->engine == NULL)
+        {
+                microtcp_set_errno(SOCKET_STATE_NOT_ESTABLISHED);
+                return -1;
+        }
+
+        /* Data the engine received comes first. Once the peer has finished sending, the engine lets go of the
+         * connection and the FIN is handled below. */
+        if (socket->engine_link != NULL)
+        {
+                ssize_t bytes_read = engine_recv(socket, buffer, length);
+                if (bytes_read != 0 || socket->engine != NULL || socket->state != ESTABLISHED)
+                        return bytes_read;
+        }
+
+        uint8_t *datagram;
+        microtcp_header_t header;
+
+        /* Without blocking, whatever has arrived is returned. */
+        if (socket->nonblocking)
+        {
+                if (connection_progress(socket) < 0)
+                        return -1;
+                if (socket->buf_fill_level == 0 && !socket->fin_received)
+                        return would_block();
+        }
+
+        /* Block until there is data, then drain whatever else has already arrived before returning,
+         * so that ACKs are coalesced over all of it. */
+        int recv_flags = NO_FLAGS_BITS;
+        while (!socket->nonblocking && !socket->fin_received)
+        {
+                if (socket->buf_fill_level > 0)
+                {
+                        recv_flags = MSG_DONTWAIT;
+                }
+                else if (socket->delack_deadline_us != 0)
+                {
+                        uint64_t now = now_us();
+                        if (now >= socket->delack_deadline_us || wait_for_segment(socket, socket->delack_deadline_us - now) == 0)
+                        {
+                                delack_timer(socket, now_us());
+                                continue;
+                        }
+                }
+
+                if (receive_segment(socket, &datagram, &header, recv_flags) < 0)
+                {
+                        if (recv_flags == MSG_DONTWAIT)
+                                break;
+                        if (MICRO_ERRNO == RECVFROM_FAILED)
+                                return -1;
+                        continue;
+                }
+
+                /* A FIN is only acted upon once every byte before it has been received. */
+                if ((header.control & (FIN_BIT | ACK_BIT)) == (FIN_BIT | ACK_BIT) && header.data_len == 0 && header.seq_number == (uint32_t) socket->ack_number)
+                {
+                        socket->ack_number = header.seq_number + 1;
+                        socket->fin_received = true;
+                        /* Acknowledged right away, the peer stops sending it again while the rest is read. */
+                        send_segment(socket, socket->seq_number, ACK_BIT, NULL, 0);
+                        break;
+                }
+
+                if (header.data_len > 0)
+                        receive_data(socket, &header, datagram + sizeof(microtcp_header_t));
+                /* Data of the batch is acknowledged once all of it has been processed, and that ACK is not
+                 * held back while the rest of the arrived data is drained. */
+                if (!rx_batch_pending(socket))
+                        delack_timer(socket, now_us());
+                if (tx_flush(socket) < 0)
+                        return -1;
+        }
+
+        /* The connection is shut down once the application has read everything before the FIN. */
+        if (socket->fin_received && socket->buf_fill_level == 0)
+        {
+                socket->fin_received = false;
+                /* Without blocking, the final ACK is waited for as microtcp_poll() is called. */
+                if (socket->cliaddr != NULL && socket->nonblocking)
+                {
+                        passive_close_start(socket);
+                        return 0;
+                }
+                if (socket->cliaddr != NULL)
+                        return server_shutdown(socket);
+                return tx_flush(socket);
+        }
+
+        size_t bytes_read = recvbuf_deliver(socket, buffer, length);
+        if (tx_flush(socket) < 0)
+                return -1;
+
+        return bytes_read;
+}
+
+int microtcp_poll(microtcp_sock_t *socket, int events, long timeout_us)
+{
+        if (socket == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+
+        /* The engine does the protocol work, only its rings are looked at. */
+        if (socket->engine != NULL)
+        {
+                int ready = engine_link_wait(socket->engine_link, events | MICROTCP_POLLCLOSED, timeout_us);
+                /* Once the engine has closed the connection, microtcp_recv() returns 0. */
+                if ((ready & ENGINE_DETACHED) && atomic_load(&socket->engine_link->peer_closed))
+                        ready = MICROTCP_POLLIN | MICROTCP_POLLCLOSED;
+                return ready & (events | MICROTCP_POLLCLOSED);
+        }
+
+        uint64_t deadline = (timeout_us > 0) ? now_us() + timeout_us : 0;
+        while (true)
+        {
+                if (connection_progress(socket) < 0)
+                        return -1;
+                int ready = poll_events(socket) & (events | MICROTCP_POLLCLOSED);
+                uint64_t now = now_us();
+                if (ready != 0 || timeout_us == 0 || (timeout_us > 0 && now >= deadline))
+                        return ready;
+
+                if (connection_wait(socket, (timeout_us > 0) ? (long) (deadline - now) : -1) < 0)
+                        return -1;
+        }
+}
+
+long microtcp_poll_timeout(const microtcp_sock_t *socket)
+{
+        if (socket == NULL || socket->engine != NULL)
+                return -1;
+
+        return connection_timeout(socket);
+}
+
+int microtcp_engine_init(microtcp_engine_t *engine)
+{
+        if (engine == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+
+        engine->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (engine->wake_fd < 0)
+        {
+                microtcp_set_errno(ENGINE_FAILED);
+                return -1;
+        }
+        engine->flags = malloc(sizeof(struct microtcp_engine_flags));
+        if (engine->flags == NULL)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                close(engine->wake_fd);
+                return -1;
+        }
+        atomic_init(&engine->flags->sleeping, false);
+        atomic_init(&engine->flags->stop, false);
+        engine->running = false;
+        engine->links = NULL;
+        engine->count = 0;
+        engine->fds = NULL;
+        engine->nfds = 0;
+        engine->rounds = 0;
+        engine->sleeps = 0;
+
+        return 0;
+}
+
+int microtcp_engine_attach(microtcp_engine_t *engine, microtcp_sock_t *socket)
+{
+        if (engine == NULL || socket == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+        if (engine->running)
+        {
+                microtcp_set_errno(ENGINE_RUNNING);
+                return -1;
+        }
+        if (socket->engine_link != NULL)
+        {
+                microtcp_set_errno(ENGINE_ATTACHED);
+                return -1;
+        }
+        if (socket->state != ESTABLISHED)
+        {
+                microtcp_set_errno(SOCKET_STATE_NOT_ESTABLISHED);
+                return -1;
+        }
+        if (socket->listener != NULL && socket->listener->engine != NULL && socket->listener->engine != engine)
+        {
+                microtcp_set_errno(ENGINE_LISTENER_SPLIT);
+                return -1;
+        }
+
+        struct microtcp_engine_link **links = realloc(engine->links, (engine->count + 1) * sizeof(*links));
+        if (links == NULL)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                return -1;
+        }
+        engine->links = links;
+
+        /* The indices of each ring sit on cache lines of their own. */
+        struct microtcp_engine_link *link = aligned_alloc(MICROTCP_CACHE_LINE, sizeof(struct microtcp_engine_link));
+        if (link == NULL)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                return -1;
+        }
+        link->tx.data = NULL;
+        link->rx.data = NULL;
+        link->event_fd = -1;
+        if (microtcp_ring_init(&link->tx, MICROTCP_ENGINE_RING_LEN) < 0 || microtcp_ring_init(&link->rx, MICROTCP_ENGINE_RING_LEN) < 0)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                engine_link_free(link);
+                return -1;
+        }
+        link->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (link->event_fd < 0)
+        {
+                microtcp_set_errno(ENGINE_FAILED);
+                engine_link_free(link);
+                return -1;
+        }
+        link->socket = socket;
+        link->listener = socket->listener;
+        atomic_init(&link->app_waiting, false);
+        atomic_init(&link->detach, false);
+        atomic_init(&link->peer_closed, false);
+        atomic_init(&link->detached, false);
+
+        engine->links[engine->count++] = link;
+        socket->engine = engine;
+        socket->engine_link = link;
+        if (socket->listener != NULL)
+                socket->listener->engine = engine;
+
+        return 0;
+}
+
+int microtcp_engine_start(microtcp_engine_t *engine)
+{
+        if (engine == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+        if (engine->running)
+        {
+                microtcp_set_errno(ENGINE_RUNNING);
+                return -1;
+        }
+
+        /* Connections of a listener the engine does not have would be routed to by the engine's thread. */
+        for (size_t i = 0; i < engine->count; i++)
+        {
+                microtcp_listener_t *listener = engine->links[i]->listener;
+                if (listener == NULL || atomic_load(&engine->links[i]->detached))
+                        continue;
+                size_t attached = 0;
+                for (size_t j = 0; j < engine->count; j++)
+                        attached += engine->links[j]->listener == listener && !atomic_load(&engine->links[j]->detached);
+                if (attached != listener->flows.count)
+                {
+                        microtcp_set_errno(ENGINE_LISTENER_SPLIT);
+                        return -1;
+                }
+        }
+
+        /* Connections of a listener share its UDP socket, it is polled once. */
+        engine->fds = malloc((engine->count + 1) * sizeof(struct pollfd));
+        if (engine->fds == NULL)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                return -1;
+        }
+        engine->nfds = 0;
+        for (size_t i = 0; i < engine->count; i++)
+        {
+                int sd = engine->links[i]->socket->sd;
+                size_t j = 0;
+                while (j < engine->nfds && engine->fds[j].fd != sd)
+                        j++;
+                if (j == engine->nfds)
+                        engine->fds[engine->nfds++] = (struct pollfd){.fd = sd, .events = POLLIN};
+        }
+        engine->fds[engine->nfds++] = (struct pollfd){.fd = engine->wake_fd, .events = POLLIN};
+
+        atomic_store(&engine->flags->stop, false);
+        if (pthread_create(&engine->thread, NULL, engine_main, engine) != 0)
+        {
+                microtcp_set_errno(ENGINE_FAILED);
+                free(engine->fds);
+                engine->fds = NULL;
+                return -1;
+        }
+        engine->running = true;
+
+        return 0;
+}
+
+int microtcp_engine_detach(microtcp_sock_t *socket)
+{
+        if (socket == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+        if (socket->engine == NULL)
+                return 0;
+
+        /* The application cannot receive on a listener's UDP socket while the engine does, unless the engine
+         * is only left to close the connection. */
+        struct microtcp_engine_link *link = socket->engine_link;
+        if (socket->listener != NULL && socket->engine->running && !atomic_load(&link->peer_closed))
+        {
+                microtcp_set_errno(ENGINE_RUNNING);
+                return -1;
+        }
+        atomic_store(&link->detach, true);
+        if (socket->engine->running)
+        {
+                engine_wake(socket->engine);
+                engine_link_wait(link, 0, -1);
+        }
+        else
+        {
+                atomic_store(&link->detached, true);
+        }
+        socket->engine = NULL;
+        if (microtcp_ring_used(&link->rx) == 0)
+                socket->engine_link = NULL;
+
+        return 0;
+}
+
+void microtcp_engine_stop(microtcp_engine_t *engine)
+{
+        if (engine == NULL)
+                return;
+
+        if (engine->running)
+        {
+                /* Written whether the engine sleeps or not, so that a sleep it is about to start ends right away. */
+                uint64_t one = 1;
+                atomic_store(&engine->flags->stop, true);
+                if (write(engine->wake_fd, &one, sizeof(one)) < 0)
+                        perror("microtcp_engine_stop() failed to wake the engine up");
+                pthread_join(engine->thread, NULL);
+                engine->running = false;
+        }
+
+        /* Connections still attached are handed back to the application's calls, and those detached with data
+         * left in their rings let go of them, as they are released here. */
+        for (size_t i = 0; i < engine->count; i++)
+        {
+                struct microtcp_engine_link *link = engine->links[i];
+                if (!atomic_load(&link->detached))
+                        link->socket->engine = NULL;
+                if (link->socket->engine_link == link)
+                        link->socket->engine_link = NULL;
+                if (link->listener != NULL)
+                        link->listener->engine = NULL;
+                engine_link_free(link);
+        }
+        free(engine->links);
+        engine->links = NULL;
+        engine->count = 0;
+
+        free(engine->fds);
+        engine->fds = NULL;
+        engine->nfds = 0;
+
+        close(engine->wake_fd);
+        engine->wake_fd = -1;
+        free(engine->flags);
+        engine->flags = NULL;
+}
+
+/* Start of definitions of inner working (helper) functions: */
+
+static inline void init_microtcp_segment(microtcp_segment_t *const __segment, uint32_t __seq_num, uint32_t __ack_num,
+                                         uint16_t __ctrl_bits, uint16_t __win_size, uint32_t __data_len, uint8_t *const __payload)
+{
+        __segment->header.seq_number = __seq_num;
+        __segment->header.ack_number = __ack_num;
+        __segment->header.control = __ctrl_bits;
+        __segment->header.window = __win_size;
+        __segment->header.data_len = __data_len;
+        /* The option fields carry SACK blocks on ACKs, a teardown segment has none to report. */
+        __segment->header.future_use0 = 0;
+        __segment->header.future_use1 = 0;
+        __segment->header.future_use2 = 0;
+        __segment->header.checksum = 0;
+        __segment->payload = __payload;
+}
+
+static void create_microtcp_bit_stream_segment(microtcp_sock_t *const socket, const microtcp_segment_t *const __segment, void **__bit_stream, size_t *__stream_len)
+{
+        /* To create an actual segment for the IP layer (3rd layer), we must pack and serialize
+         * the header and the payload. Essentially converting the microtcp_segment_t (2nd layer)
+         * into a bit-stream. Note: Padding may be required between the header and the payload.
+         * After packing and converting everything into a bit-stream, the microtcp_segment can
+         * be sent using the send() function of the underlying UDP protocol (backbone).
+         * */
+
+        size_t bit_stream_size = sizeof(microtcp_header_t); /* Valid segments contain at least a header. */
+        if (__segment == NULL)
+        {
+                fprintf(stderr, "Internal_Error: create_microtcp_net_segment() failed, as segment address was NULL.\n");
+                *__stream_len = (size_t)(*__bit_stream = NULL);
+                return;
+        }
+        if ((__segment->header.data_len == 0) != (__segment->payload == NULL)) /* XOR: Checking two conditions at once. */
+        {
+                fprintf(stderr, "Internal_Error: create_microtcp_net_segment() failed, as data_len and payload do not match.\n");
+                *__stream_len = (size_t)(*__bit_stream = NULL);
+                return;
+        }
+        bit_stream_size += __segment->header.data_len; /* If data_len == 0, then nothing changes. */
+
+        /* Take a buffer for bit_stream from the socket's pool. */
+        void *bit_stream_buffer = (bit_stream_size <= MICROTCP_POOL_SLOT_LEN) ? microtcp_pool_get(&socket->pool) : NULL;
+        if (bit_stream_buffer == NULL) /* Pools exhausted. */
+        {
+                fprintf(stderr, "Error: create_microtcp_bit_stream(): No segment buffer available.\n");
+                *__stream_len = (size_t)(*__bit_stream = NULL);
+                return;
+        }
+        /* bit_stream = header + (actual) payload. */
+        memcpy(bit_stream_buffer, &(__segment->header), sizeof(microtcp_header_t));
+        memcpy(bit_stream_buffer + sizeof(microtcp_header_t), __segment->payload, __segment->header.data_len);
+        ((microtcp_header_t *) bit_stream_buffer)->checksum = segment_checksum(segment_checksum_mode(socket, __segment->header.control), &__segment->header, __segment->payload, __segment->header.data_len);
+        *__bit_stream = bit_stream_buffer;
+        *__stream_len = bit_stream_size;
+}
+
+static void *create_bitstream(microtcp_sock_t *const socket, uint16_t control, const void *const payload, size_t payload_len, size_t *stream_len)
+{
+        if (socket == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return NULL;
+        }
+
+        microtcp_header_t header;
+        header.seq_number = socket->seq_number;
+        header.ack_number = socket->ack_number;
+        header.control = control;
+        header.window = window_field(socket, socket->curr_win_size, control);
+        header.data_len = payload_len;
+        header.future_use0 = (control & SYN_BIT) ? requested_options(socket) : 0;
+        header.future_use1 = 0;
+        header.future_use2 = 0;
+        header.checksum = segment_checksum(segment_checksum_mode(socket, control), &header, payload, payload_len);
+
+        void *bitstream = (payload_len <= MICROTCP_MSS) ? microtcp_pool_get(&socket->pool) : NULL;
+        if (bitstream == NULL)
+        {
+                microtcp_set_errno(BUFFER_POOL_EXHAUSTED);
+                return NULL;
+        }
+
+        memcpy(bitstream, &header, sizeof(microtcp_header_t));
+        memcpy(bitstream + sizeof(microtcp_header_t), payload, payload_len);
+
+        *stream_len = sizeof(microtcp_header_t) + payload_len;
+        return bitstream;
+}
+
+static int extract_bitstream(microtcp_sock_t *const socket, const void *const bitstream, size_t stream_len, microtcp_segment_t *const segment)
+{
+        if (bitstream == NULL || segment == NULL)
+        {
+                microtcp_set_errno(NULL_POINTER_ARGUMENT);
+                return -1;
+        }
+        if (stream_len < sizeof(microtcp_header_t))
+        {
+                microtcp_set_errno(RECVFROM_CORRUPTED);
+                return -1;
+        }
+
+        memcpy(&(segment->header), bitstream, sizeof(microtcp_header_t));
+        if (segment->header.data_len > stream_len - sizeof(microtcp_header_t))
+        {
+                microtcp_set_errno(RECVFROM_CORRUPTED);
+                return -1;
+        }
+        segment->payload = (segment->header.data_len > 0) ? (uint8_t *) bitstream + sizeof(microtcp_header_t) : NULL;
+        if (segment->header.checksum != segment_checksum(segment_checksum_mode(socket, segment->header.control), &segment->header, segment->payload, segment->header.data_len))
+        {
+                microtcp_set_errno(CHECKSUM_MISMATCH);
+                socket->checksum_failures++;
+                return -1;
+        }
+
+        return 0;
+}
+
+static int send_segment(microtcp_sock_t *const socket, uint32_t seq_number, uint16_t control, const void *const payload, size_t payload_len)
+{
+        uint32_t payload_crc = checksum_pass(segment_checksum_mode(socket, control), 0xffffffff, NULL, payload, payload_len);
+        return send_segment_checksummed(socket, seq_number, control, payload, payload_len, payload_crc);
+}
+
+static int send_segment_checksummed(microtcp_sock_t *const socket, uint32_t seq_number, uint16_t control, const void *const payload, size_t payload_len,
+                                    uint32_t payload_crc)
+{
+        microtcp_header_t header;
+
+        header.seq_number = seq_number;
+        header.ack_number = socket->ack_number;
+        header.control = control;
+        header.window = window_field(socket, socket->curr_win_size, control);
+        header.data_len = payload_len;
+        header.future_use0 = 0;
+        header.future_use1 = 0;
+        header.future_use2 = 0;
+        header.checksum = 0;
+        if (control & SYN_BIT)
+                header.future_use0 = negotiated_options(socket);
+        else if (socket->sack_permitted && (control & ACK_BIT))
+                sack_encode(socket, &header);
+
+        microtcp_checksum_t mode = segment_checksum_mode(socket, control);
+        header.checksum = checksum_final(mode, header_crc(mode, payload_crc, &header));
+
+        /* Scatter-gather: the kernel gathers the header and the payload into the datagram. Segments are
+         * batched, and the whole batch is handed over by one sendmmsg() when it is flushed. */
+        struct microtcp_tx_batch *batch = socket->tx_batch;
+        microtcp_header_t *queued_header = &header;
+        struct iovec single_iov[2];
+        struct iovec *iov = single_iov;
+        if (batch != NULL)
+        {
+                if (batch->count == MICROTCP_TX_BATCH && tx_flush(socket) < 0)
+                        return -1;
+                queued_header = &batch->headers[batch->count];
+                *queued_header = header;
+                iov = batch->iov[batch->count];
+        }
+        iov[0] = (struct iovec){.iov_base = queued_header, .iov_len = sizeof(microtcp_header_t)};
+        iov[1] = (struct iovec){.iov_base = (void *) payload, .iov_len = payload_len};
+        struct msghdr message = {
+                .msg_name = peer_address(socket),
+                .msg_namelen = sizeof(struct sockaddr_in),
+                .msg_iov = iov,
+                .msg_iovlen = (payload_len > 0) ? 2 : 1,
+        };
+
+        if (batch != NULL)
+        {
+                batch->messages[batch->count++].msg_hdr = message;
+        }
+        else
+        {
+                size_t stream_len = sizeof(microtcp_header_t) + payload_len;
+                if (sendmsg(socket->sd, &message, NO_FLAGS_BITS) < 0)
+                {
+                        microtcp_set_errno(SENDTO_FAILED);
+                        socket->bytes_lost += stream_len;
+                        return -1;
+                }
+                socket->tx_syscalls++;
+                socket->packets_send++;
+        }
+
+        /* Any segment carrying an ACK settles the pending one. */
+        if (control & ACK_BIT)
+        {
+                socket->segments_unacked = 0;
+                socket->delack_deadline_us = 0;
+                socket->advertised_win = (size_t) header.window << socket->rcv_wscale;
+        }
+
+        return 0;
+}
+
+static int tx_flush(microtcp_sock_t *const socket)
+{
+        struct microtcp_tx_batch *batch = socket->tx_batch;
+        if (batch == NULL || batch->count == 0)
+                return 0;
+
+        size_t sent = 0;
+        if (socket->gso_enabled)
+                sent = tx_flush_gso(socket);
+        while (sent < batch->count)
+        {
+                int ret_val = sendmmsg(socket->sd, batch->messages + sent, batch->count - sent, NO_FLAGS_BITS);
+                if (ret_val <= 0)
+                        break;
+                socket->tx_syscalls++;
+                sent += ret_val;
+        }
+        socket->packets_send += sent;
+
+        size_t count = batch->count;
+        batch->count = 0;
+        if (sent < count)
+        {
+                for (size_t i = sent; i < count; i++)
+                        socket->bytes_lost += sizeof(microtcp_header_t) + batch->headers[i].data_len;
+                microtcp_set_errno(SENDTO_FAILED);
+                return -1;
+        }
+
+        return 0;
+}
+
+static size_t tx_flush_gso(microtcp_sock_t *const socket)
+{
+        struct microtcp_tx_batch *batch = socket->tx_batch;
+
+        /* The iovecs of consecutive segments are adjacent, so a run is the header and payload iovecs of all
+         * of its segments. The kernel cuts it back into datagrams of MICROTCP_DATAGRAM_LEN bytes, so every
+         * segment of a run but the last must be full-sized. */
+        size_t runs = 0;
+        for (size_t first = 0, next; first < batch->count; first = next)
+        {
+                next = first + 1;
+                while (next < batch->count && next - first < MICROTCP_GSO_MAX_SEGMENTS && batch->headers[next - 1].data_len == MICROTCP_MSS)
+                        next++;
+
+                struct msghdr *message = &batch->gso_messages[runs].msg_hdr;
+                *message = batch->messages[first].msg_hdr;
+                if (next - first > 1)
+                {
+                        message->msg_iovlen = 2 * (next - first - 1) + batch->messages[next - 1].msg_hdr.msg_iovlen;
+                        message->msg_control = batch->gso_control.buffer;
+                        message->msg_controllen = sizeof(batch->gso_control.buffer);
+                }
+                batch->gso_first[runs++] = first;
+        }
+
+        size_t sent = 0;
+        while (sent < runs)
+        {
+                int ret_val = sendmmsg(socket->sd, batch->gso_messages + sent, runs - sent, NO_FLAGS_BITS);
+                if (ret_val <= 0)
+                {
+                        /* E.g. no checksum offload on the route: the segments are sent one by one from now on. */
+                        if (ret_val < 0 && batch->gso_messages[sent].msg_hdr.msg_control != NULL &&
+                            (errno == EIO || errno == EINVAL || errno == EMSGSIZE || errno == ENOPROTOOPT || errno == EOPNOTSUPP))
+                                socket->gso_enabled = false;
+                        break;
+                }
+                socket->tx_syscalls++;
+                sent += ret_val;
+        }
+
+        return (sent < runs) ? batch->gso_first[sent] : batch->count;
+}
+
+static int connection_buffers_init(microtcp_sock_t *const socket)
+{
+        if (socket->pool.slots == NULL && microtcp_pool_init(&socket->pool) < 0)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                return -1;
+        }
+        if (socket->tx_batch == NULL && (socket->tx_batch = malloc(sizeof(struct microtcp_tx_batch))) == NULL)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                return -1;
+        }
+        socket->tx_batch->count = 0;
+
+        /* A kernel without UDP GSO would send a run as one large datagram. */
+        int gso_size;
+        socklen_t gso_size_len = sizeof(gso_size);
+        if (socket->gso_enabled && getsockopt(socket->sd, SOL_UDP, UDP_SEGMENT, &gso_size, &gso_size_len) < 0)
+                socket->gso_enabled = false;
+        struct cmsghdr *gso_control = (struct cmsghdr *) socket->tx_batch->gso_control.buffer;
+        gso_control->cmsg_level = SOL_UDP;
+        gso_control->cmsg_type = UDP_SEGMENT;
+        gso_control->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        *(uint16_t *) CMSG_DATA(gso_control) = MICROTCP_DATAGRAM_LEN;
+
+        if (socket->rx_batch == NULL && (socket->rx_batch = rx_batch_create(&socket->pool, socket->gro_enabled)) == NULL)
+                return -1;
+        socket->rx_batch->count = 0;
+        socket->rx_batch->next = 0;
+        socket->rx_batch->offset = 0;
+
+        return 0;
+}
+
+static void connection_buffers_free(microtcp_sock_t *const socket)
+{
+        /* The rings are released with the engine, which may still look at them. When the engine closes the
+         * connection itself, the application lets go of them as it detaches. */
+        if (socket->engine == NULL)
+                socket->engine_link = NULL;
+
+        rx_batch_destroy(socket->rx_batch, &socket->pool);
+        socket->rx_batch = NULL;
+
+        free(socket->tx_batch);
+        socket->tx_batch = NULL;
+
+        microtcp_pool_free(&socket->pool);
+}
+
+static struct microtcp_rx_batch *rx_batch_create(microtcp_pool_t *pool, bool gro)
+{
+        struct microtcp_rx_batch *batch = calloc(1, sizeof(struct microtcp_rx_batch));
+        if (batch == NULL)
+        {
+                microtcp_set_errno(MALLOC_FAILED);
+                return NULL;
+        }
+
+        /* Coalesced datagrams need buffers of their own, pool slots only hold a single segment. */
+        batch->capacity = MICROTCP_RX_BATCH;
+        if (gro)
+        {
+                batch->gro_buffers = malloc(MICROTCP_GRO_BATCH * MICROTCP_GRO_BUFFER_LEN);
+                if (batch->gro_buffers == NULL)
+                {
+                        microtcp_set_errno(MALLOC_FAILED);
+                        free(batch);
+                        return NULL;
+                }
+                batch->capacity = MICROTCP_GRO_BATCH;
+        }
+
+        for (size_t i = 0; i < batch->capacity; i++)
+        {
+                batch->datagrams[i] = (batch->gro_buffers != NULL) ? batch->gro_buffers + i * MICROTCP_GRO_BUFFER_LEN : microtcp_pool_get(pool);
+                if (batch->datagrams[i] == NULL)
+                {
+                        microtcp_set_errno(BUFFER_POOL_EXHAUSTED);
+                        rx_batch_destroy(batch, pool);
+                        return NULL;
+                }
+                batch->iov[i].iov_base = batch->datagrams[i];
+                batch->iov[i].iov_len = (batch->gro_buffers != NULL) ? MICROTCP_GRO_BUFFER_LEN : MICROTCP_DATAGRAM_LEN;
+                batch->messages[i].msg_hdr.msg_iov = &batch->iov[i];
+                batch->messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        return batch;
+}
+
+static void rx_batch_destroy(struct microtcp_rx_batch *batch, microtcp_pool_t *pool)
+{
+        if (batch == NULL)
+                return;
+
+        if (batch->gro_buffers == NULL)
+        {
+                for (size_t i = 0; i < MICROTCP_RX_BATCH; i++)
+                        microtcp_pool_put(pool, batch->datagrams[i]);
+        }
+        free(batch->gro_buffers);
+        free(batch);
+}
+
+static int listener_receive(microtcp_listener_t *const listener, microtcp_sock_t *const caller, int flags)
+{
+        struct microtcp_rx_batch *batch = listener->rx_batch;
+        microtcp_sock_t *processed[MICROTCP_RX_BATCH];
+        size_t processed_count = 0;
+
+        /* A blocking wait still ends when a delayed ACK of one of the connections is due. */
+        uint64_t deadline;
+        while ((flags & MSG_DONTWAIT) == 0 && (deadline = listener_delack_timers(listener, now_us())) != 0)
+        {
+                uint64_t now = now_us();
+                long wait_us = (deadline > now) ? (long) (deadline - now) : 0;
+                struct pollfd pfd = {.fd = listener->sd, .events = POLLIN};
+                struct timespec timeout = {.tv_sec = wait_us / 1000000, .tv_nsec = (wait_us % 1000000) * 1000};
+                int ready = ppoll(&pfd, 1, &timeout, NULL);
+                if (ready < 0)
+                {
+                        microtcp_set_errno(RECVFROM_FAILED);
+                        return -1;
+                }
+                if (ready > 0)
+                        break;
+        }
+
+        /* The kernel overwrites the address lengths with those of the addresses it returned. */
+        for (size_t i = 0; i < batch->capacity; i++)
+                batch->messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+
+        int ret_val = recvmmsg(listener->sd, batch->messages, batch->capacity, (flags & MSG_DONTWAIT) ? MSG_DONTWAIT : MSG_WAITFORONE, NULL);
+        if (ret_val <= 0)
+        {
+                if ((flags & MSG_DONTWAIT) == 0)
+                        microtcp_set_errno(RECVFROM_FAILED);
+                return -1;
+        }
+        listener->rx_syscalls++;
+
+        for (int i = 0; i < ret_val; i++)
+        {
+                const uint8_t *datagram = batch->datagrams[i];
+                size_t datagram_len = batch->messages[i].msg_len;
+
+                /* Connections the application is not blocked on still take in data and acknowledge it,
+                 * otherwise their peers would stall waiting for ACKs. */
+                microtcp_sock_t *socket = microtcp_flow_lookup(&listener->flows, &batch->peers[i]);
+                if (socket != NULL && socket != caller)
+                {
+                        microtcp_header_t header;
+                        /* The final ACK of a connection an engine is closing ends its wait. */
+                        if (socket->state == CLOSING_BY_PEER)
+                        {
+                                if (parse_segment(socket, datagram, datagram_len, &header) == 0)
+                                        passive_close_input(socket, &header);
+                                continue;
+                        }
+                        if ((socket->state != ESTABLISHED && socket->state != SYN_RECEIVED) || parse_segment(socket, datagram, datagram_len, &header) < 0)
+                                continue;
+                        if (socket->state == SYN_RECEIVED)
+                                handshake_input(socket, &header);
+                        else
+                                segment_input(socket, &header, datagram + sizeof(microtcp_header_t));
+                        size_t j = 0;
+                        while (j < processed_count && processed[j] != socket)
+                                j++;
+                        if (j == processed_count)
+                                processed[processed_count++] = socket;
+                        continue;
+                }
+
+                /* Datagrams of the calling connection are validated when it processes them. Its receive
+                 * batch is a queue, and what does not fit is dropped like a lost segment. */
+                if (socket != NULL)
+                {
+                        struct microtcp_rx_batch *queue = socket->rx_batch;
+                        if (queue->next == queue->count)
+                        {
+                                queue->next = 0;
+                                queue->count = 0;
+                        }
+                        if (queue->count == queue->capacity)
+                        {
+                                socket->packets_lost++;
+                                socket->bytes_lost += datagram_len;
+                                listener->datagrams_dropped++;
+                                continue;
+                        }
+                        memcpy(queue->datagrams[queue->count], datagram, datagram_len);
+                        queue->messages[queue->count++].msg_len = datagram_len;
+                        continue;
+                }
+
+                /* A new peer is only expected to send a SYN, which waits once in the backlog. */
+                microtcp_header_t header;
+                if (datagram_len != sizeof(microtcp_header_t) || listener->backlog_count == listener->backlog_len)
+                {
+                        listener->datagrams_dropped++;
+                        continue;
+                }
+                memcpy(&header, datagram, sizeof(microtcp_header_t));
+                if (header.control != SYN_BIT || header.checksum != segment_checksum(MICROTCP_CHECKSUM_CRC32, &header, NULL, 0))
+                {
+                        listener->datagrams_dropped++;
+                        continue;
+                }
+                bool pending = false;
+                for (size_t j = 0; j < listener->backlog_count && !pending; j++)
+                {
+                        const struct sockaddr_in *peer = &listener->backlog[(listener->backlog_head + j) % listener->backlog_len].peer;
+                        pending = peer->sin_addr.s_addr == batch->peers[i].sin_addr.s_addr && peer->sin_port == batch->peers[i].sin_port;
+                }
+                if (pending)
+                        continue;
+
+                microtcp_pending_syn_t *syn = &listener->backlog[(listener->backlog_head + listener->backlog_count++) % listener->backlog_len];
+                syn->peer = batch->peers[i];
+                syn->header = header;
+        }
+
+        /* Data acknowledgements deferred to the end of the batch are sent once for all of it, those held back
+         * by the delayed ACK policy wait for their timers. */
+        uint64_t now = now_us();
+        for (size_t i = 0; i < processed_count; i++)
+        {
+                delack_timer(processed[i], now);
+                tx_flush(processed[i]);
+        }
+
+        return 0;
+}
+
+static uint64_t listener_delack_timers(microtcp_listener_t *const listener, uint64_t now)
+{
+        /* Only the earliest deadline is kept, the connections are looked at once it has passed. */
+        if (listener->delack_deadline_us == 0 || now < listener->delack_deadline_us)
+                return listener->delack_deadline_us;
+
+        uint64_t deadline = 0;
+        size_t slot = 0;
+        microtcp_sock_t *socket;
+        while ((socket = microtcp_flow_next(&listener->flows, &slot)) != NULL)
+        {
+                if (socket->state != ESTABLISHED || socket->delack_deadline_us == 0)
+                        continue;
+                delack_timer(socket, now);
+                tx_flush(socket);
+                if (socket->delack_deadline_us != 0 && (deadline == 0 || socket->delack_deadline_us < deadline))
+                        deadline = socket->delack_deadline_us;
+        }
+        listener->delack_deadline_us = deadline;
+
+        return deadline;
+}
+
+static void segment_input(microtcp_sock_t *const socket, const microtcp_header_t *const header, const uint8_t *const payload)
+{
+        /* A FIN is only acted upon once every byte before it has been received. */
+        bool fin = (header->control & (FIN_BIT | ACK_BIT)) == (FIN_BIT | ACK_BIT) && header->data_len == 0;
+        if (fin && !socket->fin_received && header->seq_number == (uint32_t) socket->ack_number)
+        {
+                socket->ack_number = header->seq_number + 1;
+                socket->fin_received = true;
+        }
+        else if (header->data_len > 0 && (socket->fin_received || !receive_data(socket, header, payload)))
+        {
+                return;
+        }
+
+        /* The FIN is acknowledged right away, so that the peer stops sending it again while the application
+         * has not read up to it, and again whenever it is retransmitted because the ACK was lost. */
+        if (fin && socket->fin_received && header->seq_number + 1 == (uint32_t) socket->ack_number)
+                send_segment(socket, socket->seq_number, ACK_BIT, NULL, 0);
+
+        /* Data is left in flight by a non-blocking microtcp_send(), its ACKs arrive while the application is elsewhere. */
+        if ((header->control & ACK_BIT) == ACK_BIT && socket->rtx_queue.una < socket->rtx_queue.end)
+                process_ack(socket, header);
+}
+
+static int accept_handshake(microtcp_sock_t *const socket, const microtcp_header_t *syn_header, const struct sockaddr *address, socklen_t address_len)
+{
+        socket->cliaddr = malloc(address_len);
+        memcpy(socket->cliaddr, address, address_len);
+
+        if (recvbuf_reserve(socket) < 0)
+                return -1;
+        socket->buf_fill_level = 0;
+        socket->recvbuf_head = 0;
+        socket->init_win_size = socket->recvbuf_len;
+        socket->rcv_rtt_start_us = 0;
+        socket->drained_bytes = 0;
+        socket->drain_start_us = now_us();
+        socket->shrink_target = 0;
+        socket->shrink_rtts = 0;
+        socket->curr_win_size = socket->recvbuf_len;
+
+        socket->seq_number = rand() | 0b1;
+        socket->ack_number = syn_header->seq_number + 1;
+        socket->peer_win_size = syn_header->window;
+        socket->sack_permitted = socket->sack_enabled && (syn_header->future_use0 & MICROTCP_OPT_SACK);
+        negotiate_window_scale(socket, syn_header->future_use0);
+        negotiate_checksum(socket, syn_header->future_use0);
+
+        /* The SYN-ACK goes out right away, and again whenever the final ACK does not arrive in time. */
+        socket->state = SYN_RECEIVED;
+        socket->handshake_deadline_us = 0;
+        return handshake_wait(socket, !socket->nonblocking);
+}
+
+static int handshake_wait(microtcp_sock_t *const socket, bool wait)
+{
+        uint8_t *datagram;
+        microtcp_header_t header;
+        int ret_val = 0;
+
+        /* The SYN or SYN-ACK is only sent again on timeout, not for every other segment received. */
+        while (ret_val == 0)
+        {
+                uint64_t now = now_us();
+                if (now >= socket->handshake_deadline_us)
+                {
+                        if (socket->state == SYN_SENT)
+                        {
+                                size_t stream_len = 0;
+                                void *bitstream = create_bitstream(socket, SYN_BIT, NULL, 0, &stream_len);
+                                if (bitstream == NULL)
+                                {
+                                        microtcp_set_errno(BITSTREAM_CREATION_FAILED);
+                                        ret_val = -1;
+                                        break;
+                                }
+                                ssize_t sent = sendto(socket->sd, bitstream, stream_len, NO_FLAGS_BITS, socket->servaddr, sizeof(struct sockaddr_in));
+                                microtcp_pool_put(&socket->pool, bitstream);
+                                if (sent < 0)
+                                {
+                                        microtcp_set_errno(SENDTO_FAILED);
+                                        socket->bytes_lost += stream_len;
+                                        ret_val = -1;
+                                        break;
+                                }
+                        }
+                        else if (send_segment(socket, socket->seq_number, SYN_BIT | ACK_BIT, NULL, 0) < 0 || tx_flush(socket) < 0)
+                        {
+                                ret_val = -1;
+                                break;
+                        }
+                        socket->handshake_deadline_us = now + MICROTCP_ACK_TIMEOUT_US;
+                }
+
+                if (wait && wait_for_segment(socket, socket->handshake_deadline_us - now) <= 0)
+                        continue;
+                if (receive_segment(socket, &datagram, &header, MSG_DONTWAIT) < 0)
+                {
+                        if (!wait && !rx_batch_pending(socket))
+                                return would_block();
+                        continue;
+                }
+                ret_val = handshake_input(socket, &header);
+        }
+
+        if (ret_val < 0 && socket->listener != NULL)
+                microtcp_flow_remove(&socket->listener->flows, (const struct sockaddr_in *) socket->cliaddr);
+        return (ret_val < 0) ? -1 : 0;
+}
+
+static int handshake_input(microtcp_sock_t *const socket, const microtcp_header_t *const header)
+{
+        if (socket->state == SYN_SENT)
+        {
+                if (header->ack_number != socket->seq_number + 1)
+                {
+                        microtcp_set_errno(ACK_NUMBER_MISMATCH);
+                        return 0;
+                }
+                if ((header->control & (SYN_BIT | ACK_BIT)) != (SYN_BIT | ACK_BIT))
+                {
+                        microtcp_set_errno(ACK_SYN_PACKET_EXPECTED);
+                        return 0;
+                }
+
+                socket->seq_number += 1;
+                socket->ack_number = header->seq_number + 1;
+                socket->peer_win_size = header->window;
+                socket->sack_permitted = socket->sack_enabled && (header->future_use0 & MICROTCP_OPT_SACK);
+                negotiate_window_scale(socket, header->future_use0);
+                negotiate_checksum(socket, header->future_use0);
+                if (rtx_queue_init(&socket->rtx_queue, socket->seq_number) < 0)
+                        return -1;
+
+                /* Complete the three-way handshake with the final ACK. */
+                if (send_segment(socket, socket->seq_number, ACK_BIT, NULL, 0) < 0 || tx_flush(socket) < 0)
+                        return -1;
+        }
+        else
+        {
+                if ((header->control & ACK_BIT) != ACK_BIT)
+                {
+                        microtcp_set_errno(ACK_PACKET_EXPECTED);
+                        return 0;
+                }
+                if (header->ack_number != socket->seq_number + 1)
+                {
+                        microtcp_set_errno(ACK_NUMBER_MISMATCH);
+                        return 0;
+                }
+
+                socket->seq_number += 1;
+                socket->peer_win_size = (size_t) header->window << socket->snd_wscale;
+                if (rtx_queue_init(&socket->rtx_queue, socket->seq_number) < 0)
+                        return -1;
+        }
+
+        /* The handshake segments must not be coalesced, GRO is only turned on once it is over. */
+        if (socket->gro_enabled)
+                udp_gro_set(socket, true);
+
+        socket->handshake_deadline_us = 0;
+        socket->state = ESTABLISHED;
+
+        return 1;
+}
+
+static int would_block(void)
+{
+        /* The normal control flow of an event loop, it is not printed like the errors are. */
+        errno = EAGAIN;
+        MICRO_ERRNO = WOULD_BLOCK;
+        return -1;
+}
+
+static int connection_progress(microtcp_sock_t *const socket)
+{
+        if (socket->state == CLOSING_BY_PEER)
+        {
+                passive_close_progress(socket);
+                return 0;
+        }
+        if (socket->state == CLOSING_BY_HOST)
+        {
+                if (active_close_progress(socket, false) < 0 && MICRO_ERRNO != WOULD_BLOCK)
+                        return -1;
+                return 0;
+        }
+        if (socket->state == SYN_SENT || socket->state == SYN_RECEIVED)
+        {
+                if (handshake_wait(socket, false) < 0 && MICRO_ERRNO != WOULD_BLOCK)
+                        return -1;
+        }
+        if (socket->state != ESTABLISHED)
+                return 0;
+
+        uint8_t *datagram;
+        microtcp_header_t header;
+        while (true)
+        {
+                if (receive_segment(socket, &datagram, &header, MSG_DONTWAIT) == 0)
+                        segment_input(socket, &header, datagram + sizeof(microtcp_header_t));
+                else if (!rx_batch_pending(socket))
+                        break;
+                /* Data of the batch is acknowledged once all of it has been processed. */
+                if (!rx_batch_pending(socket))
+                        delack_timer(socket, now_us());
+        }
+
+        uint64_t now = now_us();
+        if (socket->rto_deadline_us != 0 && now >= socket->rto_deadline_us)
+                retransmission_timeout(socket);
+        delack_timer(socket, now);
+        if (transmit_window(socket) < 0 || tx_flush(socket) < 0)
+                return -1;
+
+        return 0;
+}
+
+static int connection_wait(microtcp_sock_t *const socket, long timeout_us)
+{
+        long wait_us = connection_timeout(socket);
+        if (timeout_us >= 0 && (wait_us < 0 || wait_us > timeout_us))
+                wait_us = timeout_us;
+
+        struct pollfd pfd = {.fd = socket->sd, .events = POLLIN};
+        struct timespec timeout = {.tv_sec = wait_us / 1000000, .tv_nsec = (wait_us % 1000000) * 1000};
+        if (ppoll(&pfd, 1, (wait_us < 0) ? NULL : &timeout, NULL) < 0)
+        {
+                microtcp_set_errno(RECVFROM_FAILED);
+                return -1;
+        }
+
+        return 0;
+}
+
+static long connection_timeout(const microtcp_sock_t *const socket)
+{
+        uint64_t deadline = 0;
+        switch (socket->state)
+        {
+        case SYN_SENT:
+        case SYN_RECEIVED:
+        case CLOSING_BY_PEER:
+        case CLOSING_BY_HOST:
+                deadline = socket->handshake_deadline_us;
+                break;
+        case ESTABLISHED:
+                deadline = socket->rto_deadline_us;
+                if (socket->delack_deadline_us != 0 && (deadline == 0 || socket->delack_deadline_us < deadline))
+                        deadline = socket->delack_deadline_us;
+                /* Pacing only holds back data that is waiting to be sent. */
+                if (socket->pacing_next_us != 0 && socket->rtx_queue.nxt < socket->rtx_queue.end && (deadline == 0 || socket->pacing_next_us < deadline))
+                        deadline = socket->pacing_next_us;
+                break;
+        default:
+                return -1;
+        }
+
+        /* Datagrams already taken from the kernel do not make the UDP socket readable. */
+        if (rx_batch_pending(socket))
+                return 0;
+        if (deadline == 0)
+                return -1;
+
+        uint64_t now = now_us();
+        return (deadline > now) ? (long) (deadline - now) : 0;
+}
+
+static int poll_events(const microtcp_sock_t *const socket)
+{
+        const microtcp_rtx_queue_t *queue = &socket->rtx_queue;
+        int events = 0;
+
+        switch (socket->state)
+        {
+        case ESTABLISHED:
+                events |= MICROTCP_POLLCONNECTED;
+                if (socket->buf_fill_level > 0 || socket->fin_received)
+                        events |= MICROTCP_POLLIN;
+                /* Data an engine received before it let go of the connection. */
+                if (socket->engine_link != NULL && microtcp_ring_used(&socket->engine_link->rx) > 0)
+                        events |= MICROTCP_POLLIN;
+                if (socket->fin_received)
+                        events |= MICROTCP_POLLCLOSED;
+                /* The queue takes more data until the slot of end would wrap onto the slot of una, see rtx_queue_append(). */
+                if (queue->end / MICROTCP_MSS - queue->una / MICROTCP_MSS < MICROTCP_RTX_QUEUE_SLOTS)
+                        events |= MICROTCP_POLLOUT;
+                break;
+        case LISTEN:
+        {
+                /* A SYN is waiting for microtcp_accept(). */
+                struct pollfd pfd = {.fd = socket->sd, .events = POLLIN};
+                if (poll(&pfd, 1, 0) > 0)
+                        events |= MICROTCP_POLLIN;
+                break;
+        }
+        case CLOSED:
+                events |= MICROTCP_POLLCLOSED;
+                break;
+        default:
+                break;
+        }
+
+        return events;
+}
+
+static size_t recvbuf_deliver(microtcp_sock_t *const socket, uint8_t *buffer, size_t length)
+{
+        size_t bytes_read = (length < socket->buf_fill_level) ? length : socket->buf_fill_level;
+        recvbuf_read(socket, buffer, bytes_read);
+        recvbuf_autotune(socket, bytes_read);
+        socket->curr_win_size = socket->recvbuf_len - socket->buf_fill_level;
+
+        /* Tell the peer right away when reading opened the window by two segments or more,
+         * unless it has already finished sending. */
+        if (!socket->fin_received && socket->curr_win_size >= socket->advertised_win + 2 * MICROTCP_MSS)
+                send_segment(socket, socket->seq_number, ACK_BIT, NULL, 0);
+
+        return bytes_read;
+}
+
+static void *engine_main(void *arg)
+{
+        microtcp_engine_t *engine = arg;
+
+        while (!atomic_load(&engine->flags->stop))
+        {
+                engine->rounds++;
+                for (size_t i = 0; i < engine->count; i++)
+                {
+                        if (!atomic_load(&engine->links[i]->detached))
+                                engine_connection_run(engine->links[i]);
+                }
+
+                /* Application threads only wake the engine up once they see it sleeping. The flag is
+                 * raised before the rings are looked at again, so work handed over meanwhile is not missed. */
+                atomic_store(&engine->flags->sleeping, true);
+                atomic_thread_fence(memory_order_seq_cst);
+                long timeout_us = engine_timeout(engine);
+                if (timeout_us != 0 && !atomic_load(&engine->flags->stop))
+                {
+                        engine->sleeps++;
+                        struct timespec timeout = {.tv_sec = timeout_us / 1000000, .tv_nsec = (timeout_us % 1000000) * 1000};
+                        int ready = ppoll(engine->fds, engine->nfds, (timeout_us < 0) ? NULL : &timeout, NULL);
+                        uint64_t count;
+                        if (ready > 0 && (engine->fds[engine->nfds - 1].revents & POLLIN) && read(engine->wake_fd, &count, sizeof(count)) < 0)
+                                perror("microtcp engine failed to read its eventfd");
+                }
+                atomic_store(&engine->flags->sleeping, false);
+        }
+
+        return NULL;
+}
+
+static void engine_connection_run(struct microtcp_engine_link *const link)
+{
+        microtcp_sock_t *socket = link->socket;
+        microtcp_rtx_queue_t *queue = &socket->rtx_queue;
+        bool progress = false;
+        size_t len;
+
+        /* The engine closes a connection whose peer has finished sending without blocking, waiting for the
+         * final ACK over the next rounds. */
+        if (socket->state == CLOSING_BY_PEER)
+        {
+                if (passive_close_progress(socket))
+                {
+                        atomic_store(&link->detached, true);
+                        engine_notify(link);
+                }
+                return;
+        }
+
+        /* What the application wrote goes into the retransmission queue as far as it has room. */
+        const uint8_t *data;
+        while ((len = microtcp_ring_peek(&link->tx, &data)) > 0)
+        {
+                size_t queued = rtx_queue_append(queue, socket->checksum_mode, data, len);
+                microtcp_ring_consume(&link->tx, queued);
+                socket->bytes_send += queued;
+                progress |= queued > 0;
+                if (queued < len)
+                        break;
+        }
+        socket->seq_number = queue->iss + (uint32_t) queue->end;
 
-#define microtcp_set_errno(errno_) microtcp_set_errno(errno_, __func__, __LINE__)
+        /* Segments a failed send left out are retransmitted, the engine carries on. */
+        connection_progress(socket);
 
-/* Start of declarations of inner working (helper) functions: */
+        /* Data that arrived in order is handed over, unless the application is taking the connection back
+         * and reads it from recvbuf itself. */
+        uint8_t *space;
+        while (!atomic_load(&link->detach) && socket->buf_fill_level > 0 && (len = microtcp_ring_reserve(&link->rx, &space)) > 0)
+        {
+                microtcp_ring_commit(&link->rx, recvbuf_deliver(socket, space, len));
+                progress = true;
+        }
+        tx_flush(socket);
 
-/**
- * @deprecated
- */
-static void create_microtcp_bit_stream_segment(const microtcp_segment_t *const __segment, void **__bit_stream, size_t *__stream_len);
+        if (socket->fin_received && socket->buf_fill_level == 0 && !atomic_load(&link->peer_closed))
+        {
+                atomic_store(&link->peer_closed, true);
+                progress = true;
+        }
+        if (atomic_load(&link->detach) && microtcp_ring_used(&link->tx) == 0 && queue->una == queue->end)
+        {
+                /* Once the application has read up to the FIN of the peer, the server side is closed by the
+                 * engine, which keeps receiving on a listener's UDP socket for the other connections. */
+                if (socket->cliaddr != NULL && socket->fin_received && socket->buf_fill_level == 0)
+                {
+                        socket->fin_received = false;
+                        passive_close_start(socket);
+                        return;
+                }
+                atomic_store(&link->detached, true);
+                progress = true;
+        }
 
-/**
- * @deprecated
- */
-static inline void init_microtcp_segment(microtcp_segment_t *const __segment, uint32_t __seq_num, uint32_t __ack_num,
-                                         uint16_t __ctrl_bits, uint16_t __win_size, uint32_t __data_len, uint8_t *__payload);
+        if (progress)
+                engine_notify(link);
+}
 
-/**
- * @deprecated
- */
-static void extract_microtcp_bitstream(microtcp_segment_t **__segment, void *__bit_stream, const size_t __stream_len);
+static long engine_timeout(microtcp_engine_t *const engine)
+{
+        long timeout_us = -1;
+        for (size_t i = 0; i < engine->count; i++)
+        {
+                struct microtcp_engine_link *link = engine->links[i];
+                if (atomic_load(&link->detached))
+                        continue;
 
-/**
- * @brief Creates a MicroTCP bitstream, containing a header and (optionally) payload
- * @param socket MicroTCP socket
- * @param control control bits
- * @param payload payload, set NULL if no payload
- * @param payload_len payload size in bytes
- * @param stream_len is set to the size of the bitstream after successful creation
- * @returns the created bitstream
- */
-static void *create_bitstream(const microtcp_sock_t *const socket, uint16_t control, const void *const payload, size_t payload_len, size_t *stream_len);
+                microtcp_sock_t *socket = link->socket;
+                const microtcp_rtx_queue_t *queue = &socket->rtx_queue;
+                bool detach = atomic_load(&link->detach);
+                size_t tx_used = microtcp_ring_used(&link->tx);
+                if ((tx_used > 0 && queue->end / MICROTCP_MSS - queue->una / MICROTCP_MSS < MICROTCP_RTX_QUEUE_SLOTS) ||
+                    (!detach && socket->buf_fill_level > 0 && microtcp_ring_used(&link->rx) < link->rx.capacity) ||
+                    (detach && socket->state == ESTABLISHED && tx_used == 0 && queue->una == queue->end))
+                        return 0;
+
+                long wait_us = connection_timeout(socket);
+                if (wait_us >= 0 && (timeout_us < 0 || wait_us < timeout_us))
+                        timeout_us = wait_us;
+        }
 
-/**
- * @brief Extracts a MicroTCP bitstream, returning the packet's header and saving its payload in the socket receive buffer
- * @param socket MicroTCP socket
- * @param bitstream bitstream to extract
- * @returns packet header
- */
-static microtcp_segment_t *extract_bitstream(const void *const bitstream);
+        return timeout_us;
+}
 
-static int server_shutdown(microtcp_sock_t *socket);
+static void engine_wake(microtcp_engine_t *const engine)
+{
+        uint64_t one = 1;
+        atomic_thread_fence(memory_order_seq_cst);
+        if (atomic_load(&engine->flags->sleeping) && write(engine->wake_fd, &one, sizeof(one)) < 0)
+                perror("microtcp failed to wake the engine up");
+}
 
-/* REMOVE BEFORE SUBMISSION. */
-static void print_bitstream(void *stream, size_t length)
+static void engine_notify(struct microtcp_engine_link *const link)
 {
-        char *str = stream;
-        for (size_t i = 0; i < length; i++)
-                printf("%d | ", str[i]);
-        printf("\n");
+        uint64_t one = 1;
+        atomic_thread_fence(memory_order_seq_cst);
+        if (atomic_load(&link->app_waiting) && write(link->event_fd, &one, sizeof(one)) < 0)
+                perror("microtcp engine failed to wake the application up");
 }
 
-/* End   of declarations of inner working (helper) functions. */
+static int engine_link_events(struct microtcp_engine_link *const link)
+{
+        if (atomic_load(&link->detached))
+                return ENGINE_DETACHED;
+
+        /* While the engine closes the connection for a non-blocking microtcp_recv(), nothing is reported
+         * until it lets go. */
+        int events = MICROTCP_POLLCONNECTED;
+        bool peer_closed = atomic_load(&link->peer_closed) && !atomic_load(&link->detach);
+        if (microtcp_ring_used(&link->rx) > 0 || peer_closed)
+                events |= MICROTCP_POLLIN;
+        if (peer_closed)
+                events |= MICROTCP_POLLCLOSED;
+        if (microtcp_ring_used(&link->tx) < link->tx.capacity)
+                events |= MICROTCP_POLLOUT;
+
+        return events;
+}
 
-microtcp_sock_t microtcp_socket(int domain, int type, int protocol)
+static int engine_link_wait(struct microtcp_engine_link *const link, int events, long timeout_us)
 {
-        microtcp_sock_t micro_sock;
+        uint64_t deadline = (timeout_us > 0) ? now_us() + timeout_us : 0;
+        events |= ENGINE_DETACHED;
 
-        micro_sock.state = READY;
-        if (domain != AF_INET)
+        while (true)
         {
-                fprintf(stderr, "Warning: MicroTCP only accepts AF_INET (IPv4) as its socket domain parameter.\n");
-                micro_sock.state = WARNING;
+                /* The engine only writes event_fd once it sees the flag, which is raised before the rings
+                 * are looked at, see engine_notify(). */
+                atomic_store(&link->app_waiting, true);
+                atomic_thread_fence(memory_order_seq_cst);
+                int ready = engine_link_events(link) & events;
+                uint64_t now = now_us();
+                if (ready != 0 || timeout_us == 0 || (timeout_us > 0 && now >= deadline))
+                {
+                        atomic_store(&link->app_waiting, false);
+                        return ready;
+                }
+
+                long wait_us = (timeout_us > 0) ? (long) (deadline - now) : -1;
+                struct pollfd pfd = {.fd = link->event_fd, .events = POLLIN};
+                struct timespec timeout = {.tv_sec = wait_us / 1000000, .tv_nsec = (wait_us % 1000000) * 1000};
+                uint64_t count;
+                if (ppoll(&pfd, 1, (wait_us < 0) ? NULL : &timeout, NULL) > 0 && read(link->event_fd, &count, sizeof(count)) < 0)
+                        perror("microtcp failed to read the eventfd of a connection");
+                atomic_store(&link->app_waiting, false);
         }
-        if (type != SOCK_DGRAM || (protocol != 0 && protocol != IPPROTO_UDP))
+}
+
+static ssize_t engine_recv(microtcp_sock_t *const socket, uint8_t *buffer, size_t length)
+{
+        struct microtcp_engine_link *link = socket->engine_link;
+        if (length == 0)
+                return 0;
+
+        while (true)
         {
-                fprintf(stderr, "Warning: MicroTCP only accepts UDP protocol as its backbone.\n");
-                micro_sock.state = WARNING;
+                size_t bytes_read = microtcp_ring_read(&link->rx, buffer, length);
+                if (bytes_read > 0)
+                {
+                        /* The engine may be waiting for room to move the rest of recvbuf. */
+                        if (socket->engine != NULL)
+                                engine_wake(socket->engine);
+                        return bytes_read;
+                }
+                /* Once detached, nothing is added to the ring, the connection lets go of it when it is empty. */
+                if (socket->engine == NULL)
+                {
+                        socket->engine_link = NULL;
+                        return 0;
+                }
+
+                /* Everything before the FIN has been read, the engine closes the connection and lets go of it.
+                 * The ring is read once more, data may have been added between the read above and the FIN. */
+                if (atomic_load(&link->peer_closed))
+                {
+                        /* Without blocking, the engine is left to send its FIN again until the peer acknowledges
+                         * it, and 0 is returned once it has let go. */
+                        if (socket->nonblocking && socket->engine->running && (engine_link_events(link) & ENGINE_DETACHED) == 0)
+                        {
+                                if (!atomic_exchange(&link->detach, true))
+                                        engine_wake(socket->engine);
+                                return would_block();
+                        }
+                        if (microtcp_engine_detach(socket) < 0)
+                                return -1;
+                        continue;
+                }
+                if (socket->nonblocking)
+                        return would_block();
+                engine_link_wait(link, MICROTCP_POLLIN, -1);
         }
-        if ((micro_sock.sd = socket(domain, type, protocol)) < 0)
+}
+
+static void engine_link_free(struct microtcp_engine_link *link)
+{
+        if (link == NULL)
+                return;
+
+        microtcp_ring_free(&link->tx);
+        microtcp_ring_free(&link->rx);
+        if (link->event_fd >= 0)
+                close(link->event_fd);
+        free(link);
+}
+
+static void udp_gro_set(microtcp_sock_t *const socket, bool on)
+{
+        int value = on;
+        if (setsockopt(socket->sd, SOL_UDP, UDP_GRO, &value, sizeof(value)) < 0 && on)
+                socket->gro_enabled = false;
+}
+
+static int rx_batch_receive(microtcp_sock_t *const socket, int flags)
+{
+        struct microtcp_rx_batch *batch = socket->rx_batch;
+
+        /* The kernel overwrites the control buffer lengths with what it returned. */
+        for (size_t i = 0; batch->gro_buffers != NULL && i < batch->capacity; i++)
         {
-                fprintf(stderr, "Error: Unable to create socket for MicroTCP.\n");
-                micro_sock.state = INVALID;
+                batch->messages[i].msg_hdr.msg_control = batch->gro_control[i].buffer;
+                batch->messages[i].msg_hdr.msg_controllen = sizeof(batch->gro_control[i].buffer);
         }
 
-        /* Default initializations: */
-        micro_sock.init_win_size = MICROTCP_WIN_SIZE;
+        /* Only the first datagram is waited for, the rest are taken if they have already arrived. */
+        int ret_val = recvmmsg(socket->sd, batch->messages, batch->capacity, (flags & MSG_DONTWAIT) ? MSG_DONTWAIT : MSG_WAITFORONE, NULL);
+        if (ret_val <= 0)
+        {
+                if ((flags & MSG_DONTWAIT) == 0)
+                        microtcp_set_errno(RECVFROM_FAILED);
+                return -1;
+        }
+        socket->rx_syscalls++;
+        batch->count = ret_val;
+        batch->next = 0;
+        batch->offset = 0;
 
-        micro_sock.curr_win_size = MICROTCP_INIT_CWND; /* TODO: Should these two be the same? */
-        micro_sock.cwnd = MICROTCP_INIT_CWND;
+        return 0;
+}
 
-        micro_sock.recvbuf = NULL;
-        micro_sock.buf_fill_level = 0;
-        micro_sock.ssthresh = MICROTCP_INIT_SSTHRESH;
-        micro_sock.seq_number = rand() | 0b1; /* Random number not zero. */
-        micro_sock.ack_number = 0;            /* Undefined. */
-        micro_sock.packets_send = 0;
-        micro_sock.packets_received = 0;
-        micro_sock.packets_lost = 0;
-        micro_sock.bytes_send = 0;
-        micro_sock.bytes_received = 0;
-        micro_sock.bytes_lost = 0;
+static int receive_segment(microtcp_sock_t *const socket, uint8_t **datagram, microtcp_header_t *header, int flags)
+{
+        struct microtcp_rx_batch *batch = socket->rx_batch;
 
-        micro_sock.servaddr = NULL;
-        micro_sock.cliaddr = NULL;
+        if (batch->next == batch->count)
+        {
+                /* Nothing is left batched while blocking. */
+                if ((flags & MSG_DONTWAIT) == 0 && tx_flush(socket) < 0)
+                        return -1;
 
-        return micro_sock;
+                /* The UDP socket of a listener is shared, what it receives is routed to each connection. */
+                if (socket->listener == NULL)
+                {
+                        if (rx_batch_receive(socket, flags) < 0)
+                                return -1;
+                }
+                else
+                {
+                        if (listener_receive(socket->listener, socket, flags) < 0)
+                                return -1;
+                        if (batch->next == batch->count)
+                        {
+                                /* Not an error, but the normal outcome on a busy listener, it is not reported. */
+                                MICRO_ERRNO = SEGMENT_FOR_OTHER_CONNECTION;
+                                return -1;
+                        }
+                }
+        }
+
+        /* A datagram that was not coalesced is a single segment. */
+        struct mmsghdr *message = &batch->messages[batch->next];
+        if (batch->offset == 0)
+        {
+                batch->segment_len = message->msg_len;
+                struct cmsghdr *control = (batch->gro_buffers != NULL) ? CMSG_FIRSTHDR(&message->msg_hdr) : NULL;
+                for (; control != NULL; control = CMSG_NXTHDR(&message->msg_hdr, control))
+                {
+                        int gso_size;
+                        if (control->cmsg_level != SOL_UDP || control->cmsg_type != UDP_GRO)
+                                continue;
+                        memcpy(&gso_size, CMSG_DATA(control), sizeof(gso_size));
+                        if (gso_size > 0)
+                                batch->segment_len = gso_size;
+                }
+        }
+
+        size_t datagram_len = message->msg_len - batch->offset;
+        if (datagram_len > batch->segment_len)
+                datagram_len = batch->segment_len;
+        *datagram = batch->datagrams[batch->next] + batch->offset;
+        batch->offset += datagram_len;
+        if (batch->offset >= message->msg_len)
+        {
+                batch->next++;
+                batch->offset = 0;
+        }
+
+        return parse_segment(socket, *datagram, datagram_len, header);
 }
 
-int microtcp_bind(microtcp_sock_t *socket, const struct sockaddr *address, socklen_t address_len)
+static int parse_segment(microtcp_sock_t *const socket, const uint8_t *datagram, size_t datagram_len, microtcp_header_t *header)
 {
-        /* Essential check-ups. Reporting errors. */
-        if (socket == NULL || socket->sd < 0 || socket->state != READY)
+        if (datagram_len < sizeof(microtcp_header_t))
         {
-                if (socket == NULL)
-                        fprintf(stderr, "Error: microtcp_bind() failed, socket address was NULL.\n");
-                else if (socket->sd < 0)
-                        fprintf(stderr, "Error: File descriptor of MicroTCP socket was invalid.\n");
-                else if (socket->state != READY)
-                        fprintf(stderr, "Error: MicroTCP socket was not in a READY state.\n");
+                microtcp_set_errno(RECVFROM_CORRUPTED);
+                socket->packets_lost++;
+                socket->bytes_lost += datagram_len;
                 return -1;
         }
 
-        /* Upon successful completion, bind() shall return 0; otherwise,
-         * -1 shall be returned and errno set to indicate the error.  */
-        int bind_ret_val = bind(socket->sd, address, address_len);
-        if (bind_ret_val == 0)          /* Thus bind() was successful. */
-                socket->state = LISTEN; /* Socket is ready for incoming connection. */
-        else                            /* Bind failed. */
-                fprintf(stderr, "Error: microtcp_bind() failed.\n");
+        memcpy(header, datagram, sizeof(microtcp_header_t));
+        if (header->data_len != datagram_len - sizeof(microtcp_header_t))
+        {
+                microtcp_set_errno(RECVFROM_CORRUPTED);
+                socket->packets_lost++;
+                socket->bytes_lost += datagram_len;
+                return -1;
+        }
+        /* The checksum of data segments is verified by receive_data(), while the payload is copied. */
+        if (header->data_len == 0 && header->checksum != segment_checksum(segment_checksum_mode(socket, header->control), header, NULL, 0))
+        {
+                microtcp_set_errno(CHECKSUM_MISMATCH);
+                socket->checksum_failures++;
+                socket->packets_lost++;
+                socket->bytes_lost += datagram_len;
+                return -1;
+        }
+        socket->packets_received++;
 
-        socket->servaddr = malloc(address_len);
-        memcpy(socket->servaddr, address, address_len);
+        return 0;
+}
 
-        return bind_ret_val;
+static inline bool rx_batch_pending(const microtcp_sock_t *const socket)
+{
+        return socket->rx_batch->next < socket->rx_batch->count;
 }
 
-/* PHASE B TODO: compartmentalize functions even further.
- *Inner loops will be need for packet loss management.
- * */
-/** @return Upon successful completion, connect() shall return 0; otherwise, -1 . */
-int microtcp_connect(microtcp_sock_t *socket, const struct sockaddr *address, socklen_t address_len)
+static int wait_for_segment(microtcp_sock_t *const socket, long timeout_us)
 {
+        if (tx_flush(socket) < 0)
+                return -1;
+        if (rx_batch_pending(socket))
+                return 1;
 
-        if (socket == NULL || socket->state != READY)
+        /* On the UDP socket of a listener, the delayed ACKs of the other connections end the wait too. */
+        if (socket->listener != NULL)
         {
-                microtcp_set_errno(socket == NULL ? NULL_POINTER_ARGUMENT : SOCKET_STATE_NOT_READY);
-                return -1;
+                uint64_t now = now_us();
+                uint64_t deadline = listener_delack_timers(socket->listener, now);
+                if (deadline != 0 && deadline > now && (long) (deadline - now) < timeout_us)
+                        timeout_us = deadline - now;
         }
 
-        /* Send SYN packet. */
-        size_t stream_len = 0;
-        void *bitstream_send = create_bitstream(socket, SYN_BIT, NULL, 0, &stream_len); /* Used to send SYN packet and later ACK packet. */
-        if (bitstream_send == NULL)
+        struct pollfd pfd = {.fd = socket->sd, .events = POLLIN};
+        struct timespec timeout = {.tv_sec = timeout_us / 1000000, .tv_nsec = (timeout_us % 1000000) * 1000};
+
+        /* ppoll() rather than poll(), pacing needs sub-millisecond sleeps. */
+        int ret_val = ppoll(&pfd, 1, &timeout, NULL);
+        if (ret_val < 0)
+                microtcp_set_errno(RECVFROM_FAILED);
+
+        return ret_val;
+}
+
+static bool receive_data(microtcp_sock_t *const socket, const microtcp_header_t *const header, const uint8_t *const payload)
+{
+        /* A retransmission may cover bytes that were already received, skip them. */
+        uint32_t seq_number = header->seq_number;
+        size_t len = header->data_len;
+        const uint8_t *payload_start;
+        size_t ooo_count = socket->ooo_count;
+        bool in_order = false;
+        uint32_t duplicate = (uint32_t) socket->ack_number - seq_number;
+        if (SEQ_LT(seq_number, socket->ack_number) && duplicate < len)
         {
-                microtcp_set_errno(BITSTREAM_CREATION_FAILED);
-                return -1;
+                seq_number += duplicate;
+                len -= duplicate;
         }
-        do
+
+        /* Data inside the window is placed at its offset in recvbuf, the next expected bytes are
+         * delivered together with any out-of-order ranges they make contiguous. */
+        uint32_t distance = seq_number - (uint32_t) socket->ack_number;
+        payload_start = payload + (header->data_len - len);
+        bool in_window = SEQ_GEQ(seq_number, socket->ack_number) && distance + len <= socket->recvbuf_len - socket->buf_fill_level;
+
+        /* In-order data that does not reach buffered out-of-order data is checksummed while it is copied
+         * to its place, which is only taken into account once the checksum matches. Everything else is
+         * checksummed in place, so that a corrupted segment never overwrites data already received. */
+        bool fused = in_window && distance == 0 && (socket->ooo_count == 0 || SEQ_GEQ(socket->ooo_ranges[0].start, seq_number + len));
+        microtcp_checksum_t mode = segment_checksum_mode(socket, header->control);
+        uint32_t crc = checksum_pass(mode, 0xffffffff, NULL, payload, header->data_len - len);
+        if (fused)
+                crc = recvbuf_write(socket, socket->buf_fill_level, payload_start, len, crc);
+        else
+                crc = checksum_pass(mode, crc, NULL, payload_start, len);
+        if (checksum_final(mode, header_crc(mode, crc, header)) != header->checksum)
         {
-                ssize_t syn_ret_val = sendto(socket->sd, bitstream_send, stream_len, NO_FLAGS_BITS, address, address_len);
-                if (syn_ret_val < 0)
-                {
-                        microtcp_set_errno(SENDTO_FAILED);
-                        socket->bytes_lost += stream_len;
-                        free(bitstream_send);
-                        return -1;
-                }
+                microtcp_set_errno(CHECKSUM_MISMATCH);
+                socket->checksum_failures++;
+                socket->packets_lost++;
+                socket->bytes_lost += sizeof(microtcp_header_t) + header->data_len;
+                return false;
+        }
 
-                /* Receive ACK-SYN packet. */
-                ssize_t ack_syn_ret_val = recvfrom(socket->sd, socket->recvbuf, stream_len, NO_FLAGS_BITS, (struct sockaddr *)address, &address_len);
-                if (ack_syn_ret_val < 0)
-                        continue; /* Nothing in receive buffers yet. */ /*TODO add counter.*/
-                else if ((size_t) ack_syn_ret_val <= sizeof(microtcp_header_t))
-                {
-                        microtcp_set_errno(RECVFROM_CORRUPTED);
-                        socket->packets_lost++;
-                        socket->bytes_lost += (ack_syn_ret_val > 0) ? ack_syn_ret_val : 0;
-                        continue;
-                }
-                microtcp_segment_t *received_segment = extract_bitstream(socket->recvbuf);
-                if (received_segment == NULL)
+        if (in_window)
+        {
+                if (distance == 0)
                 {
-                        microtcp_set_errno(BITSTREAM_EXTRACTION_FAILED);
-                        continue;
+                        in_order = (len == header->data_len);
+                        if (!fused)
+                                recvbuf_write(socket, socket->buf_fill_level, payload_start, len, 0);
+                        socket->buf_fill_level += len;
+                        socket->ack_number += len;
+                        socket->bytes_received += len;
+
+                        while (socket->ooo_count > 0 && SEQ_LEQ(socket->ooo_ranges[0].start, socket->ack_number))
+                        {
+                                if (SEQ_GT(socket->ooo_ranges[0].end, socket->ack_number))
+                                {
+                                        size_t contiguous = socket->ooo_ranges[0].end - (uint32_t) socket->ack_number;
+                                        socket->buf_fill_level += contiguous;
+                                        socket->ack_number += contiguous;
+                                        socket->bytes_received += contiguous;
+                                }
+                                socket->ooo_count--;
+                                memmove(&socket->ooo_ranges[0], &socket->ooo_ranges[1], socket->ooo_count * sizeof(microtcp_seq_range_t));
+                                if (socket->ooo_last > 0)
+                                        socket->ooo_last--;
+                        }
                 }
-                if (received_segment->header.ack_number != socket->seq_number + 1)
+                else if (ooo_range_insert(socket, seq_number, seq_number + len))
                 {
-                        microtcp_set_errno(ACK_NUMBER_MISMATCH);
-                        continue;
+                        recvbuf_write(socket, socket->buf_fill_level + distance, payload_start, len, 0);
                 }
-                if ((received_segment->header.control & (SYN_BIT | ACK_BIT)) != (SYN_BIT | ACK_BIT))
+        }
+        socket->curr_win_size = socket->recvbuf_len - socket->buf_fill_level;
+        if (in_order)
+                rcv_rtt_measure(socket);
+
+        /* In-order data followed by more datagrams of the receive batch is acknowledged after the batch. */
+        if (in_order && socket->ooo_count == ooo_count && socket->delack_timeout_us != 0 && rx_batch_pending(socket))
+        {
+                socket->segments_unacked++;
+                socket->delack_deadline_us = now_us();
+                return true;
+        }
+
+        /* Out-of-order, duplicate or hole-filling data and short segments are acknowledged at once, in-order
+         * full-sized segments every ack_every segments or when the delayed ACK timer expires. */
+        if (in_order && socket->ooo_count == ooo_count && header->data_len == MICROTCP_MSS && socket->delack_timeout_us != 0 && ++socket->segments_unacked < socket->ack_every)
+        {
+                if (socket->delack_deadline_us == 0)
                 {
-                        microtcp_set_errno(ACK_SYN_PACKET_EXPECTED);
-                        continue;
+                        socket->delack_deadline_us = now_us() + socket->delack_timeout_us;
+                        if (socket->listener != NULL &&
+                            (socket->listener->delack_deadline_us == 0 || socket->delack_deadline_us < socket->listener->delack_deadline_us))
+                                socket->listener->delack_deadline_us = socket->delack_deadline_us;
                 }
-                break;
-        } while (true);
+                return true;
+        }
 
-        socket->servaddr = malloc(address_len);
-        memcpy(socket->servaddr, address, address_len);
+        send_segment(socket, socket->seq_number, ACK_BIT, NULL, 0);
+        return true;
+}
 
-        socket->recvbuf = malloc(MICROTCP_RECVBUF_LEN);
+static uint32_t recvbuf_write(microtcp_sock_t *const socket, size_t position, const uint8_t *data, size_t len, uint32_t crc)
+{
+        size_t index = (socket->recvbuf_head + position) % socket->recvbuf_len;
+        size_t first = (len < socket->recvbuf_len - index) ? len : socket->recvbuf_len - index;
 
-        socket->state = ESTABLISHED;
-        return 0;
+        microtcp_checksum_t mode = socket->checksum_mode;
+        crc = checksum_pass(mode, crc, socket->recvbuf + index, data, first);
+        return checksum_pass(mode, crc, socket->recvbuf, data + first, len - first);
 }
 
-int microtcp_accept(microtcp_sock_t *socket, struct sockaddr *address, socklen_t address_len)
+static void recvbuf_read(microtcp_sock_t *const socket, uint8_t *buffer, size_t len)
 {
-        if (socket == NULL || socket->state != LISTEN)
+        size_t first = (len < socket->recvbuf_len - socket->recvbuf_head) ? len : socket->recvbuf_len - socket->recvbuf_head;
+
+        memcpy(buffer, socket->recvbuf + socket->recvbuf_head, first);
+        memcpy(buffer + first, socket->recvbuf, len - first);
+
+        socket->recvbuf_head = (socket->recvbuf_head + len) % socket->recvbuf_len;
+        socket->buf_fill_level -= len;
+}
+
+static bool ooo_range_insert(microtcp_sock_t *const socket, uint32_t start, uint32_t end)
+{
+        microtcp_seq_range_t *ranges = socket->ooo_ranges;
+
+        /* Ranges [first, last) overlap or touch [start, end). */
+        size_t first = 0;
+        while (first < socket->ooo_count && SEQ_LT(ranges[first].end, start))
+                first++;
+        size_t last = first;
+        while (last < socket->ooo_count && SEQ_LEQ(ranges[last].start, end))
+                last++;
+
+        if (first == last)
         {
-                if (socket == NULL)
-                        fprintf(stderr, "Error: microtcp_accept() failed, socket address was NULL.\n");
-                else
-                        fprintf(stderr, "Error: microtcp_accept() failed, as given socket was not in LISTEN state.\n");
-                return -1;
+                if (socket->ooo_count == MICROTCP_OOO_RANGES)
+                        return false;
+                memmove(&ranges[first + 1], &ranges[first], (socket->ooo_count - first) * sizeof(microtcp_seq_range_t));
+                socket->ooo_count++;
+        }
+        else
+        {
+                if (SEQ_LT(ranges[first].start, start))
+                        start = ranges[first].start;
+                if (SEQ_GT(ranges[last - 1].end, end))
+                        end = ranges[last - 1].end;
+                memmove(&ranges[first + 1], &ranges[last], (socket->ooo_count - last) * sizeof(microtcp_seq_range_t));
+                socket->ooo_count -= last - first - 1;
+        }
+
+        ranges[first].start = start;
+        ranges[first].end = end;
+        socket->ooo_last = first;
+
+        return true;
+}
+
+static void rcv_rtt_measure(microtcp_sock_t *const socket)
+{
+        uint64_t now = now_us();
+        if (socket->rcv_rtt_start_us != 0)
+        {
+                if (SEQ_LEQ(socket->ack_number, socket->rcv_rtt_seq))
+                        return;
+
+                /* A sender that does not fill the window inflates the sample, so only the smallest one is kept. */
+                uint64_t sample = now - socket->rcv_rtt_start_us;
+                if (socket->rcv_rtt_us == 0 || sample < socket->rcv_rtt_us)
+                        socket->rcv_rtt_us = sample;
+        }
+
+        /* Bytes past the right edge of the window can only be sent after an ACK that has not left yet. */
+        socket->rcv_rtt_seq = socket->ack_number + socket->curr_win_size;
+        socket->rcv_rtt_start_us = now;
+}
+
+static void recvbuf_autotune(microtcp_sock_t *const socket, size_t bytes_read)
+{
+        uint64_t now = now_us();
+        socket->drained_bytes += bytes_read;
+        if (socket->rcv_rtt_us == 0 || now - socket->drain_start_us < socket->rcv_rtt_us)
+                return;
+
+        /* Twice the drain rate times the RTT leaves the sender room to keep growing its window. */
+        uint64_t elapsed = now - socket->drain_start_us;
+        size_t target = 2 * (socket->drained_bytes * socket->rcv_rtt_us / elapsed);
+        socket->drained_bytes = 0;
+        socket->drain_start_us = now;
+
+        if (target < socket->recvbuf_min_len)
+                target = socket->recvbuf_min_len;
+        if (target > socket->recvbuf_max_len)
+                target = socket->recvbuf_max_len;
+
+        /* Shrinking must keep the data held and the right edge of the advertised window. */
+        size_t in_use = socket->buf_fill_level + socket->advertised_win;
+        if (socket->ooo_count > 0)
+        {
+                size_t ooo_end = socket->buf_fill_level + (uint32_t) (socket->ooo_ranges[socket->ooo_count - 1].end - (uint32_t) socket->ack_number);
+                if (ooo_end > in_use)
+                        in_use = ooo_end;
+        }
+        if (target < in_use)
+                target = in_use;
+
+        /* Sizes move in powers of two, growth at least doubles the buffer so that a rising rate reallocates it
+         * a few times only, and a shrink waits until the estimates have stayed low for a while. */
+        if (target > socket->recvbuf_len)
+        {
+                size_t len = 2 * socket->recvbuf_len;
+                while (len < target)
+                        len *= 2;
+                socket->shrink_target = 0;
+                socket->shrink_rtts = 0;
+                recvbuf_resize(socket, (len < socket->recvbuf_reserved) ? len : socket->recvbuf_reserved);
+        }
+        else if (target <= socket->recvbuf_len / 4)
+        {
+                if (target > socket->shrink_target)
+                        socket->shrink_target = target;
+                if (++socket->shrink_rtts < MICROTCP_RECVBUF_SHRINK_RTTS)
+                        return;
+
+                /* The buffer keeps twice the largest estimate, so that the next one does not grow it right back. */
+                size_t len = socket->recvbuf_len;
+                while (len / 2 >= 2 * socket->shrink_target && len / 2 >= socket->recvbuf_min_len)
+                        len /= 2;
+                socket->shrink_target = 0;
+                socket->shrink_rtts = 0;
+                recvbuf_resize(socket, len);
+        }
+        else
+        {
+                socket->shrink_target = 0;
+                socket->shrink_rtts = 0;
+        }
+}
+
+static void recvbuf_resize(microtcp_sock_t *const socket, size_t len)
+{
+        /* Growing, the bytes that wrapped around are appended to the end of the old ring. Otherwise the ring is
+         * unrolled in place by three reversals, and the next byte to be delivered moves to the start. */
+        uint8_t *recvbuf = socket->recvbuf;
+        size_t head = socket->recvbuf_head;
+        if (len >= socket->recvbuf_len + head)
+        {
+                memcpy(recvbuf + socket->recvbuf_len, recvbuf, head);
+        }
+        else if (head != 0)
+        {
+                size_t spans[3][2] = {{0, head}, {head, socket->recvbuf_len}, {0, socket->recvbuf_len}};
+                for (size_t i = 0; i < 3; i++)
+                {
+                        for (size_t lo = spans[i][0], hi = spans[i][1]; lo + 1 < hi; lo++, hi--)
+                        {
+                                uint8_t byte = recvbuf[lo];
+                                recvbuf[lo] = recvbuf[hi - 1];
+                                recvbuf[hi - 1] = byte;
+                        }
+                }
+                socket->recvbuf_head = 0;
         }
 
-        microtcp_segment_t *recv_syn_segment;
-        microtcp_segment_t sent_ack_segment;
-        size_t stream_len = sizeof(microtcp_header_t);
-        void *bit_stream = malloc(stream_len);
+        /* The pages a shrink gives up are returned, they are backed again on first use. */
+        size_t page = sysconf(_SC_PAGESIZE);
+        size_t kept = (len + page - 1) / page * page;
+        if (kept < socket->recvbuf_len)
+                madvise(recvbuf + kept, socket->recvbuf_len - kept, MADV_DONTNEED);
+
+        socket->recvbuf_len = len;
+        socket->curr_win_size = len - socket->buf_fill_level;
+}
 
-        int ret_val;
-        ret_val = recvfrom(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, address, &address_len);
-        extract_microtcp_bitstream(&recv_syn_segment, bit_stream, stream_len);
-        if (recv_syn_segment->header.control != SYN_BIT)
+static int recvbuf_reserve(microtcp_sock_t *const socket)
+{
+        void *recvbuf = mmap(NULL, socket->recvbuf_max_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (recvbuf == MAP_FAILED)
         {
-                fprintf(stderr, "Error: microtcp_accept() failed, SYN segment was invalid\n");
-                free(bit_stream);
+                socket->recvbuf = NULL;
+                microtcp_set_errno(MALLOC_FAILED);
                 return -1;
         }
 
-        socket->seq_number = rand() | 0b1;
-        socket->ack_number = recv_syn_segment->header.seq_number + 1;
+        socket->recvbuf = recvbuf;
+        socket->recvbuf_reserved = socket->recvbuf_max_len;
+        return 0;
+}
 
-        init_microtcp_segment(&sent_ack_segment, socket->seq_number, socket->ack_number, SYN_BIT | ACK_BIT, socket->init_win_size, 0, NULL);
-        create_microtcp_bit_stream_segment(&sent_ack_segment, &bit_stream, &stream_len);
-        if (bit_stream == NULL || stream_len == 0)
-        {
-                fprintf(stderr, "Error: microtcp_accept() failed, bit-stream conversion failed.\n");
-                return -1;
-        }
+static void recvbuf_release(microtcp_sock_t *const socket)
+{
+        if (socket->recvbuf != NULL)
+                munmap(socket->recvbuf, socket->recvbuf_reserved);
+        socket->recvbuf = NULL;
+        socket->recvbuf_reserved = 0;
+}
 
-        sendto(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, address, address_len);
+static void delack_timer(microtcp_sock_t *const socket, uint64_t now)
+{
+        if (socket->delack_deadline_us != 0 && now >= socket->delack_deadline_us)
+                send_segment(socket, socket->seq_number, ACK_BIT, NULL, 0);
+}
 
-        microtcp_segment_t *recv_ack_segment;
-        stream_len = sizeof(microtcp_segment_t);
-        recvfrom(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, address, &address_len);
-        extract_microtcp_bitstream(&recv_ack_segment, bit_stream, stream_len);
-        if ((sent_ack_segment.header.control & ACK_BIT) != ACK_BIT || recv_ack_segment->header.ack_number != sent_ack_segment.header.seq_number + 1)
+static int rtx_queue_init(microtcp_rtx_queue_t *const queue, uint32_t iss)
+{
+        queue->segments = malloc(MICROTCP_RTX_QUEUE_SLOTS * sizeof(microtcp_rtx_segment_t));
+        queue->data = malloc(MICROTCP_RTX_QUEUE_SLOTS * MICROTCP_MSS);
+        if (queue->segments == NULL || queue->data == NULL)
         {
-                fprintf(stderr, "Error: microtcp_accept() failed, ACK segment was invalid.\n");
-                free(bit_stream);
+                microtcp_set_errno(MALLOC_FAILED);
+                rtx_queue_free(queue);
                 return -1;
         }
 
-        // TODO: ASK TA: Is this correct? (Undefined). socket->seq_number += 1;
-        socket->ack_number = recv_ack_segment->header.seq_number + 1;
+        queue->iss = iss;
+        queue->una = 0;
+        queue->nxt = 0;
+        queue->high = 0;
+        queue->end = 0;
 
-        socket->cliaddr = malloc(address_len);
-        memcpy(socket->cliaddr, address, address_len);
+        return 0;
+}
 
-        socket->recvbuf = malloc(MICROTCP_RECVBUF_LEN);
+static void rtx_queue_free(microtcp_rtx_queue_t *const queue)
+{
+        free(queue->segments);
+        queue->segments = NULL;
 
-        socket->state = ESTABLISHED;
+        free(queue->data);
+        queue->data = NULL;
+}
 
-        free(bit_stream);
+static size_t rtx_queue_append(microtcp_rtx_queue_t *const queue, microtcp_checksum_t mode, const uint8_t *buffer, size_t length)
+{
+        size_t queued = 0;
+        while (queued < length)
+        {
+                /* The ring is full once the slot of end would wrap onto the slot of una. */
+                uint64_t first_slot = queue->una / MICROTCP_MSS;
+                uint64_t last_slot = queue->end / MICROTCP_MSS;
+                if (last_slot - first_slot >= MICROTCP_RTX_QUEUE_SLOTS)
+                        break;
+
+                microtcp_rtx_segment_t *slot = rtx_queue_slot(queue, queue->end);
+                size_t slot_fill = queue->end % MICROTCP_MSS;
+                /* A fresh slot, or one whose earlier bytes have all been acknowledged, starts a new segment. */
+                if (slot_fill == 0 || queue->una == queue->end)
+                {
+                        slot->offset = queue->end;
+                        slot->len = 0;
+                        slot->payload_crc = 0xffffffff;
+                        slot->transmissions = 0;
+                        slot->sacked = false;
+                }
 
-        return 0;
+                size_t chunk = MICROTCP_MSS - slot_fill;
+                if (chunk > length - queued)
+                        chunk = length - queued;
+                slot->payload_crc = checksum_pass(mode, slot->payload_crc, rtx_queue_payload(queue, queue->end), buffer + queued, chunk);
+
+                slot->len += chunk;
+                queue->end += chunk;
+                queued += chunk;
+        }
+
+        return queued;
 }
 
-int microtcp_shutdown(microtcp_sock_t *socket, int how)
+static bool rtx_queue_ack_offset(const microtcp_rtx_queue_t *const queue, uint32_t ack_number, uint64_t *offset)
 {
-        if (socket == NULL)
-        {
-                fprintf(stderr, "Error: microtcp_shutdown() failed, socket was NULL.\n");
+        uint32_t distance = ack_number - (queue->iss + (uint32_t) queue->una);
+        if (distance > queue->high - queue->una)
+                return false;
+
+        *offset = queue->una + distance;
+        return true;
+}
+
+static ssize_t transmit_from_queue(microtcp_sock_t *const socket, uint64_t offset, size_t max_len)
+{
+        microtcp_rtx_queue_t *queue = &socket->rtx_queue;
+        microtcp_rtx_segment_t *slot = rtx_queue_slot(queue, offset);
+
+        size_t len = slot->offset + slot->len - offset;
+        if (len > max_len)
+                len = max_len;
+
+        /* The checksum of the payload is known unless only part of the segment is sent. */
+        const uint8_t *payload = rtx_queue_payload(queue, offset);
+        microtcp_checksum_t mode = socket->checksum_mode;
+        uint32_t payload_crc = (offset == slot->offset && len == slot->len) ? slot->payload_crc : checksum_pass(mode, 0xffffffff, NULL, payload, len);
+        if (send_segment_checksummed(socket, queue->iss + (uint32_t) offset, ACK_BIT, payload, len, payload_crc) < 0)
                 return -1;
-        }
-        if (socket->state != ESTABLISHED)
+        /* Bytes appended to a slot already in flight go out for the first time, which starts a fresh count for Karn's rule. */
+        if (offset >= queue->high)
         {
-                fprintf(stderr, "Error: microtcp_shutdown() failed, socket state was not ESTABLISHED.\n");
-                return -1;
+                slot->transmissions = 1;
+                slot->sent_offset = offset;
         }
-        if (socket->cliaddr != NULL)
+        else
         {
-                fprintf(stderr, "Error: microtcp_shutdown() failed, shutdown cannot be called by the server.\n");
-                return -1;
+                slot->transmissions++;
         }
+        slot->sent_us = now_us();
+        if (socket->rto_deadline_us == 0)
+                socket->rto_deadline_us = slot->sent_us + socket->rto_us;
 
-        switch (how)
-        {
-        /* Block both */
-        default:
-                microtcp_segment_t sent_fin_ack_segment;
-                size_t stream_len;
-                void *bit_stream;
-                int len;
-                init_microtcp_segment(&sent_fin_ack_segment, socket->seq_number, socket->ack_number, FIN_BIT | ACK_BIT, socket->curr_win_size, 0, NULL);
-                create_microtcp_bit_stream_segment(&sent_fin_ack_segment, &bit_stream, &stream_len);
-                sendto(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, socket->servaddr, sizeof(struct sockaddr));
-
-                len = sizeof(microtcp_segment_t);
-                microtcp_segment_t *recv_ack_segment;
-                stream_len = sizeof(microtcp_segment_t);
-                bit_stream = malloc(stream_len);
-                recvfrom(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, socket->servaddr, &len);
-                extract_microtcp_bitstream(&recv_ack_segment, bit_stream, stream_len);
-                if ((recv_ack_segment->header.control & ACK_BIT) != ACK_BIT || recv_ack_segment->header.ack_number != socket->seq_number + 1)
-                {
-                        fprintf(stderr, "Error: microtcp_shutdown() failed, received ACK segment was invalid.\n");
-                        return -1;
-                }
+        return len;
+}
 
-                socket->state = CLOSING_BY_HOST;
+static int transmit_window(microtcp_sock_t *const socket)
+{
+        microtcp_rtx_queue_t *queue = &socket->rtx_queue;
+        size_t window = (socket->cwnd < socket->peer_win_size) ? socket->cwnd : socket->peer_win_size;
 
-                len = sizeof(microtcp_segment_t);
-                microtcp_segment_t *recv_fin_ack_segment;
-                recvfrom(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, socket->servaddr, &len);
-                extract_microtcp_bitstream(&recv_fin_ack_segment, bit_stream, stream_len);
-                if ((recv_fin_ack_segment->header.control & (FIN_BIT | ACK_BIT)) != (FIN_BIT | ACK_BIT))
+        while (queue->nxt < queue->end)
+        {
+                size_t in_flight = queue->nxt - queue->una;
+                microtcp_rtx_segment_t *slot = rtx_queue_slot(queue, queue->nxt);
+                size_t chunk = slot->offset + slot->len - queue->nxt;
+                /* Going back after a timeout, segments the peer has selectively acknowledged are skipped. */
+                if (slot->sacked && queue->nxt < queue->high)
                 {
-                        fprintf(stderr, "Error: microtcp_shutdown() failed, received FIN ACK segment was invalid.\n");
-                        return -1;
+                        queue->nxt += chunk;
+                        continue;
                 }
+                /* With nothing in flight whatever fits in the window is sent, a single byte probes a closed one. */
+                if (in_flight + chunk > window)
+                {
+                        if (in_flight > 0)
+                                break;
+                        chunk = (window > 0) ? window : 1;
+                }
+                if (!pacing_take(socket, sizeof(microtcp_header_t) + chunk))
+                        break;
 
-                socket->seq_number += 1;
-                socket->ack_number = recv_fin_ack_segment->header.seq_number + 1;
-
-                microtcp_segment_t sent_ack_segment;
-                init_microtcp_segment(&sent_ack_segment, socket->seq_number, socket->ack_number, ACK_BIT, socket->curr_win_size, 0, NULL);
-                create_microtcp_bit_stream_segment(&sent_ack_segment, &bit_stream, &stream_len);
-                sendto(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, socket->servaddr, sizeof(struct sockaddr));
-
-                socket->state = CLOSED;
-
-                free(socket->servaddr);
-                socket->servaddr = NULL;
-
-                free(socket->recvbuf);
-                socket->recvbuf = NULL;
-
-                break;
-
-        /* TODO: Phase B (probably?) */
-        /* Block recv */
-        case SHUT_RD:
-                break;
-
-        /* Block send */
-        case SHUT_WR:
-                break;
+                ssize_t sent = transmit_from_queue(socket, queue->nxt, chunk);
+                if (sent < 0)
+                        return -1;
+                queue->nxt += sent;
+                if (queue->nxt > queue->high)
+                        queue->high = queue->nxt;
         }
 
         return 0;
 }
 
-ssize_t microtcp_send(microtcp_sock_t *socket, const void *buffer, size_t length, int flags)
+static void process_ack(microtcp_sock_t *const socket, const microtcp_header_t *const header)
 {
-        if (length > MICROTCP_MSS)
+        microtcp_rtx_queue_t *queue = &socket->rtx_queue;
+        uint64_t offset;
+
+        size_t previous_win_size = socket->peer_win_size;
+        socket->peer_win_size = (size_t) header->window << socket->snd_wscale;
+        if (!rtx_queue_ack_offset(queue, header->ack_number, &offset))
+                return;
+        if (socket->sack_permitted)
+                sack_update_scoreboard(socket, header);
+
+        if (offset == queue->una)
         {
-                size_t bytes_left = length;
-                while (bytes_left > MICROTCP_MSS)
+                /* A pure ACK that repeats una while data is outstanding and the window is unchanged is a duplicate. */
+                if (queue->una == queue->high || header->data_len > 0 || socket->peer_win_size != previous_win_size)
+                        return;
+
+                socket->dup_acks++;
+                if (socket->dup_acks == MICROTCP_DUP_ACK_THRESHOLD && !socket->in_recovery)
+                {
+                        /* Fast retransmit, then NewReno fast recovery until everything sent so far is acknowledged. */
+                        socket->cc_ops->on_loss(socket, MICROTCP_LOSS_FAST);
+                        socket->cwnd += MICROTCP_DUP_ACK_THRESHOLD * MICROTCP_MSS;
+                        socket->in_recovery = true;
+                        socket->recover = queue->high;
+                        socket->packets_lost++;
+                        socket->sack_rtx_next = queue->una;
+                        if (socket->sack_permitted)
+                                sack_retransmit_hole(socket);
+                        else
+                                transmit_from_queue(socket, queue->una, MICROTCP_MSS);
+                }
+                else if (socket->in_recovery)
                 {
-                        socket->seq_number += MICROTCP_MSS;
-                        microtcp_send(socket, buffer, MICROTCP_MSS, flags);
-                        buffer += MICROTCP_MSS;
-                        bytes_left -= MICROTCP_MSS;
+                        /* Every further duplicate means a segment has left the network, inflate the window. */
+                        socket->cwnd += MICROTCP_MSS;
+                        if (socket->sack_permitted)
+                                sack_retransmit_hole(socket);
                 }
-
-                socket->seq_number += bytes_left;
-                microtcp_send(socket, buffer, bytes_left, flags); /* Sends final chunk. */
-
-                return length;
+                return;
         }
 
-        socket->seq_number += length;
+        size_t acked = offset - queue->una;
+        socket->dup_acks = 0;
 
-        size_t stream_len;
-        void *bitstream = create_bitstream(socket, NO_FLAGS_BITS, buffer, length, &stream_len);
+        /* Karn's rule: only bytes that were transmitted once give an unambiguous RTT sample. */
+        microtcp_rtx_segment_t *slot = rtx_queue_slot(queue, offset - 1);
+        if (slot->transmissions == 1 && offset > slot->sent_offset)
+                rtt_sample(socket, now_us() - slot->sent_us);
 
-        struct sockaddr *dest = (socket->cliaddr == NULL) ? socket->servaddr : socket->cliaddr;
-        sendto(socket->sd, bitstream, stream_len, NO_FLAGS_BITS, dest, sizeof(*dest));
+        /* Cumulative ACK: everything below offset is released at once. */
+        queue->una = offset;
+        if (queue->nxt < queue->una)
+                queue->nxt = queue->una;
 
-        free(bitstream);
-        if (bitstream == NULL)
+        if (socket->in_recovery)
         {
-                microtcp_set_errno(MALLOC_FAILED);
-                return -1;
+                if (offset >= socket->recover)
+                {
+                        /* Full ACK, deflate the window and leave fast recovery. */
+                        socket->cwnd = socket->ssthresh;
+                        socket->in_recovery = false;
+                }
+                else
+                {
+                        /* Partial ACK, the next hole is retransmitted right away. */
+                        socket->cwnd = (socket->cwnd > acked) ? socket->cwnd - acked + MICROTCP_MSS : MICROTCP_MSS;
+                        if (socket->sack_permitted)
+                                sack_retransmit_hole(socket);
+                        else
+                                transmit_from_queue(socket, queue->una, MICROTCP_MSS);
+                }
+        }
+        else
+        {
+                socket->cc_ops->on_ack(socket, acked);
         }
 
-        socklen_t len = sizeof(*dest);
-        recvfrom(socket->sd, socket->recvbuf, sizeof(microtcp_header_t), NO_FLAGS_BITS, dest, &len);
-        microtcp_segment_t *ack_packet = extract_bitstream(socket->recvbuf);
+        /* Restart the retransmission timer for the remaining data, or stop it. */
+        socket->rto_deadline_us = (queue->una < queue->high) ? now_us() + socket->rto_us : 0;
+}
 
-        if ((ack_packet->header.control & ACK_BIT != ACK_BIT) || (ack_packet->header.seq_number != socket->seq_number + 1))
+static void sack_encode(const microtcp_sock_t *const socket, microtcp_header_t *const header)
+{
+        /* The block of the most recent segment goes first, the rest follow in sequence order. */
+        const microtcp_seq_range_t *ranges[MICROTCP_SACK_BLOCKS];
+        size_t count = 0;
+        uint32_t farthest = 0;
+        for (size_t i = 0; i <= socket->ooo_count && count < MICROTCP_SACK_BLOCKS; i++)
         {
-                microtcp_set_errno(ACK_NUMBER_MISMATCH);
-                return -1;
+                size_t index = (i == 0) ? socket->ooo_last : i - 1;
+                if (index >= socket->ooo_count || (i > 0 && index == socket->ooo_last))
+                        continue;
+
+                ranges[count++] = &socket->ooo_ranges[index];
+                if (ranges[count - 1]->end - header->ack_number > farthest)
+                        farthest = ranges[count - 1]->end - header->ack_number;
         }
 
-        return stream_len - sizeof(microtcp_header_t);
+        /* Each block is 16 bits of distance from the ACK number followed by 16 bits of length, both shifted
+         * right by the smallest shift that fits the farthest block, so that the blocks reach across the whole
+         * window. The shift goes in the low bits of the control field. The start of a block is rounded up and
+         * its end down, a block never covers bytes that have not arrived. */
+        uint8_t shift = 0;
+        while (shift < MICROTCP_SACK_SHIFT_MASK && (farthest >> shift) > UINT16_MAX)
+                shift++;
+
+        uint32_t blocks[MICROTCP_SACK_BLOCKS] = {0};
+        size_t encoded = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+                uint32_t start = (uint32_t) (((uint64_t) (ranges[i]->start - header->ack_number) + (1u << shift) - 1) >> shift);
+                uint32_t end = (ranges[i]->end - header->ack_number) >> shift;
+                if (end <= start || end > UINT16_MAX)
+                        continue;
+                blocks[encoded++] = (start << 16) | (end - start);
+        }
+
+        header->control |= shift;
+        header->future_use0 = blocks[0];
+        header->future_use1 = blocks[1];
+        header->future_use2 = blocks[2];
 }
 
-ssize_t microtcp_recv(microtcp_sock_t *socket, void *buffer, size_t length, int flags)
+static void sack_update_scoreboard(microtcp_sock_t *const socket, const microtcp_header_t *const header)
 {
-        void *bitstream = malloc(length);
-        struct sockaddr *dest = (socket->cliaddr == NULL) ? socket->servaddr : socket->cliaddr;
+        microtcp_rtx_queue_t *queue = &socket->rtx_queue;
+        const uint32_t blocks[MICROTCP_SACK_BLOCKS] = {header->future_use0, header->future_use1, header->future_use2};
+        uint8_t shift = header->control & MICROTCP_SACK_SHIFT_MASK;
 
-        socklen_t len = sizeof(*dest);
-        ssize_t bytes_read = recvfrom(socket->sd, bitstream, length, NO_FLAGS_BITS, dest, &len);
-        microtcp_header_t packet; /* = extract_bitstream(socket, bitstream);*/
+        for (size_t i = 0; i < MICROTCP_SACK_BLOCKS; i++)
+        {
+                if ((blocks[i] & UINT16_MAX) == 0)
+                        continue;
 
-        free(bitstream);
+                /* Blocks are scaled as sack_encode() scaled them. */
+                uint32_t start_seq = header->ack_number + ((blocks[i] >> 16) << shift);
+                uint32_t end_seq = start_seq + ((blocks[i] & UINT16_MAX) << shift);
+                uint64_t start;
+                uint64_t end;
+                if (!rtx_queue_ack_offset(queue, start_seq, &start) || !rtx_queue_ack_offset(queue, end_seq, &end))
+                        continue;
 
-        socket->ack_number = packet.seq_number + 1;
+                /* Only segments that lie entirely inside the block are marked. */
+                for (uint64_t offset = start; offset < end;)
+                {
+                        microtcp_rtx_segment_t *slot = rtx_queue_slot(queue, offset);
+                        uint64_t slot_end = slot->offset + slot->len;
+                        if (slot_end <= offset)
+                                break;
+                        if (slot->offset >= start && slot_end <= end)
+                                slot->sacked = true;
+                        offset = slot_end;
+                }
+                if (end > socket->sack_high)
+                        socket->sack_high = end;
+        }
+}
 
-        memcpy(buffer, socket->recvbuf, packet.data_len);
+static void sack_retransmit_hole(microtcp_sock_t *const socket)
+{
+        microtcp_rtx_queue_t *queue = &socket->rtx_queue;
+        uint64_t offset = (socket->sack_rtx_next > queue->una) ? socket->sack_rtx_next : queue->una;
 
-        if (socket->cliaddr != NULL && (packet.control & (FIN_BIT | ACK_BIT)) == (FIN_BIT | ACK_BIT))
+        /* The first unacknowledged segment is always a hole, anything past the highest SACK is not known to be. */
+        while (offset == queue->una || offset < socket->sack_high)
         {
-                return server_shutdown(socket);
+                if (offset >= queue->high)
+                        break;
+
+                microtcp_rtx_segment_t *slot = rtx_queue_slot(queue, offset);
+                uint64_t slot_end = slot->offset + slot->len;
+                if (!slot->sacked)
+                {
+                        transmit_from_queue(socket, offset, MICROTCP_MSS);
+                        socket->sack_rtx_next = slot_end;
+                        return;
+                }
+                offset = slot_end;
         }
+        socket->sack_rtx_next = offset;
+}
 
-        size_t stream_len;
-        bitstream = create_bitstream(socket, ACK_BIT, NULL, 0, &stream_len);
-        sendto(socket->sd, bitstream, stream_len, NO_FLAGS_BITS, dest, sizeof(*dest));
-        free(bitstream);
+static uint64_t pacing_rate(const microtcp_sock_t *const socket)
+{
+        uint64_t rate = (socket->cc_ops->pacing_rate != NULL) ? socket->cc_ops->pacing_rate(socket) : 0;
+        if (rate == 0 && socket->srtt_us != 0)
+        {
+                /* Twice cwnd per SRTT during slow start, so that pacing never holds back window growth, 1.2 times after. */
+                uint64_t gain = (socket->cwnd < socket->ssthresh) ? 200 : 120;
+                rate = (uint64_t) socket->cwnd * 1000000 / socket->srtt_us * gain / 100;
+        }
+        if (socket->max_pacing_rate != 0 && (rate == 0 || rate > socket->max_pacing_rate))
+                rate = socket->max_pacing_rate;
 
-        if (bytes_read == -1)
-                return -1;
-        return bytes_read - sizeof(microtcp_header_t);
+        return rate;
 }
 
-/* Start of definitions of inner working (helper) functions: */
-
-static inline void init_microtcp_segment(microtcp_segment_t *const __segment, uint32_t __seq_num, uint32_t __ack_num,
-                                         uint16_t __ctrl_bits, uint16_t __win_size, uint32_t __data_len, uint8_t *const __payload)
+static bool pacing_take(microtcp_sock_t *const socket, size_t segment_len)
 {
-        __segment->header.seq_number = __seq_num;
-        __segment->header.ack_number = __ack_num;
-        __segment->header.control = __ctrl_bits;
-        __segment->header.window = __win_size;
-        __segment->header.data_len = __data_len;
-        /* init_segment.header.future_use0 = NYI */
-        /* init_segment.header.future_use1 = NYI */
-        /* init_segment.header.future_use2 = NYI */
-        /* init_segment.header.checksum = NYI */
-        __segment->payload = __payload;
+        uint64_t rate = socket->pacing_enabled ? pacing_rate(socket) : 0;
+        socket->pacing_rate = rate;
+        socket->pacing_next_us = 0;
+        if (rate == 0)
+                return true;
+
+        /* Token bucket: tokens accrue at the pacing rate, up to a small burst. */
+        uint64_t now = now_us();
+        uint64_t elapsed = now - socket->pacing_last_us;
+        socket->pacing_tokens = (elapsed < 1000000) ? socket->pacing_tokens + elapsed * rate / 1000000 : MICROTCP_PACING_BURST;
+        if (socket->pacing_tokens > MICROTCP_PACING_BURST)
+                socket->pacing_tokens = MICROTCP_PACING_BURST;
+        socket->pacing_last_us = now;
+
+        if (socket->pacing_tokens < segment_len)
+        {
+                socket->pacing_next_us = now + (segment_len - socket->pacing_tokens) * 1000000 / rate + 1;
+                return false;
+        }
+        socket->pacing_tokens -= segment_len;
+
+        return true;
 }
 
-static void create_microtcp_bit_stream_segment(const microtcp_segment_t *const __segment, void **__bit_stream, size_t *__stream_len)
+static void rtt_sample(microtcp_sock_t *const socket, uint64_t rtt_us)
 {
-        /* To create an actual segment for the IP layer (3rd layer), we must pack and serialize
-         * the header and the payload. Essentially converting the microtcp_segment_t (2nd layer)
-         * into a bit-stream. Note: Padding may be required between the header and the payload.
-         * After packing and converting everything into a bit-stream, the microtcp_segment can
-         * be sent using the send() function of the underlying UDP protocol (backbone).
-         * */
-
-        size_t bit_stream_size = sizeof(microtcp_header_t); /* Valid segments contain at least a header. */
-        if (__segment == NULL)
+        if (socket->srtt_us == 0)
         {
-                fprintf(stderr, "Internal_Error: create_microtcp_net_segment() failed, as segment address was NULL.\n");
-                *__stream_len = (size_t)(*__bit_stream = NULL);
-                return;
+                socket->srtt_us = rtt_us;
+                socket->rttvar_us = rtt_us / 2;
         }
-        if ((__segment->header.data_len == 0) != (__segment->payload == NULL)) /* XOR: Checking two conditions at once. */
+        else
         {
-                fprintf(stderr, "Internal_Error: create_microtcp_net_segment() failed, as data_len and payload do not match.\n");
-                *__stream_len = (size_t)(*__bit_stream = NULL);
-                return;
+                uint64_t delta = (socket->srtt_us > rtt_us) ? socket->srtt_us - rtt_us : rtt_us - socket->srtt_us;
+                socket->rttvar_us = (3 * socket->rttvar_us + delta) / 4;
+                socket->srtt_us = (7 * socket->srtt_us + rtt_us) / 8;
         }
-        bit_stream_size += __segment->header.data_len; /* If data_len == 0, then nothing changes. */
 
-        /* Allocate memory for bit_stream. */
-        void *bit_stream_buffer = malloc(bit_stream_size);
-        if (bit_stream_buffer == NULL) /* Malloc() failed. */
-        {
-                fprintf(stderr, "Error: create_microtcp_bit_stream(): Memory Allocation failed, malloc() failed.\n");
-                *__stream_len = (size_t)(*__bit_stream = NULL);
-                return;
-        }
-        /* bit_stream = header + (actual) payload. */
-        memcpy(bit_stream_buffer, &(__segment->header), sizeof(microtcp_header_t));
-        memcpy(bit_stream_buffer + sizeof(microtcp_header_t), __segment->payload, __segment->header.data_len);
-        *__bit_stream = bit_stream_buffer;
-        *__stream_len = bit_stream_size;
+        /* RTO = SRTT + 4 * RTTVAR, which also drops any backoff. */
+        socket->rto_us = socket->srtt_us + 4 * socket->rttvar_us;
+        if (socket->rto_us < socket->rto_min_us)
+                socket->rto_us = socket->rto_min_us;
+        if (socket->rto_us > socket->rto_max_us)
+                socket->rto_us = socket->rto_max_us;
+
+        if (socket->cc_ops->on_rtt_sample != NULL)
+                socket->cc_ops->on_rtt_sample(socket, rtt_us);
 }
 
-static void *create_bitstream(const microtcp_sock_t *const socket, uint16_t control, const void *const payload, size_t payload_len, size_t *stream_len)
+static void retransmission_timeout(microtcp_sock_t *const socket)
 {
-        if (socket == NULL)
-        {
-                microtcp_set_errno(NULL_POINTER_ARGUMENT);
-                return NULL;
-        }
+        microtcp_rtx_queue_t *queue = &socket->rtx_queue;
 
-        microtcp_header_t header;
-        header.seq_number = socket->seq_number;
-        header.ack_number = socket->ack_number;
-        header.control = control;
-        header.window = socket->curr_win_size;
-        header.data_len = payload_len;
-        /* init_segment.header.future_use0 = NYI */
-        /* init_segment.header.future_use1 = NYI */
-        /* init_segment.header.future_use2 = NYI */
-        /* init_segment.header.checksum = NYI */
+        socket->packets_lost++;
+        socket->bytes_lost += queue->nxt - queue->una;
 
-        void *bitstream = malloc(sizeof(microtcp_header_t) + payload_len);
-        if (bitstream == NULL)
-        {
-                microtcp_set_errno(MALLOC_FAILED);
-                return NULL;
-        }
+        /* The whole flight is considered lost. */
+        socket->cc_ops->on_loss(socket, MICROTCP_LOSS_TIMEOUT);
+        socket->dup_acks = 0;
+        socket->in_recovery = false;
 
-        memcpy(bitstream, &header, sizeof(microtcp_header_t));
-        memcpy(bitstream + sizeof(microtcp_header_t), payload, payload_len);
+        /* Exponential backoff, kept until a valid RTT sample arrives. */
+        socket->rto_us *= 2;
+        if (socket->rto_us > socket->rto_max_us)
+                socket->rto_us = socket->rto_max_us;
 
-        *stream_len = sizeof(microtcp_header_t) + payload_len;
-        return bitstream;
+        /* Go back to the first unacknowledged byte, the timer is re-armed by the retransmission. */
+        queue->nxt = queue->una;
+        socket->rto_deadline_us = 0;
 }
 
-static microtcp_segment_t *extract_bitstream(const void *const bitstream)
+static int server_shutdown(microtcp_sock_t *socket)
 {
-        microtcp_segment_t *segment = malloc(sizeof(microtcp_segment_t));
-        if (bitstream == NULL || segment == NULL)
-        {
-                microtcp_set_errno(bitstream == NULL ? NULL_POINTER_ARGUMENT : MALLOC_FAILED);
-                return NULL;
-        }
+        passive_close_start(socket);
 
-        memcpy(&(segment->header), bitstream, sizeof(microtcp_header_t));
-        if (segment->header.data_len > 0)
-                segment->payload = malloc(segment->header.data_len);
-        if (segment->payload == NULL)
+        /* On the shared UDP socket of a listener, what arrives for the connection is routed here by the
+         * listener, and the wait also ends early for the delayed ACKs of the other connections. */
+        while (!passive_close_progress(socket))
         {
-                microtcp_set_errno(MALLOC_FAILED);
-                return segment;
+                uint64_t now = now_us();
+                if (now < socket->handshake_deadline_us && wait_for_segment(socket, socket->handshake_deadline_us - now) < 0)
+                {
+                        passive_close_finish(socket);
+                        return -1;
+                }
         }
 
-        memcpy((segment->payload), bitstream + sizeof(microtcp_header_t), segment->header.data_len);
+        return 0;
+}
+
+static void passive_close_start(microtcp_sock_t *const socket)
+{
+        tx_flush(socket);
+        if (socket->gro_enabled)
+                udp_gro_set(socket, false);
+
+        socket->seq_number += 1;
+        send_segment(socket, socket->seq_number, ACK_BIT, NULL, 0);
+
+        socket->state = CLOSING_BY_PEER;
+        socket->fin_acked = false;
+        socket->fin_retransmissions = 0;
+
+        socket->seq_number += 1;
+        send_segment(socket, socket->seq_number, FIN_BIT | ACK_BIT, NULL, 0);
+        tx_flush(socket);
 
-        return segment;
+        socket->handshake_deadline_us = now_us() + socket->rto_us;
 }
 
-static void extract_microtcp_bitstream(microtcp_segment_t **__segment, void *__bit_stream, const size_t __stream_len)
+static void passive_close_input(microtcp_sock_t *const socket, const microtcp_header_t *const header)
 {
+        /* The FIN-ACK acknowledges the FIN of the peer as well, it is sent again when the peer has not seen it. */
+        if ((header->control & FIN_BIT) == FIN_BIT)
+        {
+                send_segment(socket, socket->seq_number, FIN_BIT | ACK_BIT, NULL, 0);
+                tx_flush(socket);
+        }
+        else if ((header->control & ACK_BIT) == ACK_BIT && header->ack_number == (uint32_t) (socket->seq_number + 1))
+        {
+                /* Closed on the next round, an engine does not sleep until the retransmission. */
+                socket->fin_acked = true;
+                socket->handshake_deadline_us = now_us();
+        }
+}
 
-        if (__stream_len < sizeof(microtcp_header_t))
+static bool passive_close_progress(microtcp_sock_t *const socket)
+{
+        uint8_t *datagram;
+        microtcp_header_t header;
+        while (!socket->fin_acked)
         {
-                fprintf(stderr, "Error: extract_microtcp_bitstream() __stream_len less than minimum valid value.\n");
-                *__segment = NULL;
-                return;
+                if (receive_segment(socket, &datagram, &header, MSG_DONTWAIT) == 0)
+                        passive_close_input(socket, &header);
+                else if (!rx_batch_pending(socket))
+                        break;
         }
-        microtcp_segment_t *segment = malloc(sizeof(microtcp_segment_t));
 
-        if (segment == NULL)
+        /* The FIN is sent again with backoff, like data is, and the peer is given up on after the last try. */
+        uint64_t now = now_us();
+        if (!socket->fin_acked && now < socket->handshake_deadline_us)
+                return false;
+        if (!socket->fin_acked && socket->fin_retransmissions < MICROTCP_FIN_RETRIES)
         {
-                fprintf(stderr, "Error: extract_microtcp_bitstream(): Memory Allocation failed, malloc() failed.\n");
-                *__segment = NULL;
-                return;
+                send_segment(socket, socket->seq_number, FIN_BIT | ACK_BIT, NULL, 0);
+                tx_flush(socket);
+                socket->fin_retransmissions++;
+                socket->rto_us *= 2;
+                if (socket->rto_us > socket->rto_max_us)
+                        socket->rto_us = socket->rto_max_us;
+                socket->handshake_deadline_us = now + socket->rto_us;
+                return false;
         }
-        memcpy(&(segment->header), __bit_stream, sizeof(microtcp_header_t));
-        segment->payload = (segment->header.data_len > 0) ? malloc(segment->header.data_len) : NULL;
-        memcpy(segment->payload, __bit_stream + sizeof(microtcp_header_t), segment->header.data_len);
-        *__segment = segment;
+
+        passive_close_finish(socket);
+        return true;
 }
 
-static int server_shutdown(microtcp_sock_t *socket)
+static void passive_close_finish(microtcp_sock_t *const socket)
 {
-        microtcp_segment_t sent_ack_segment;
-        void *bit_stream;
-        size_t stream_len;
-        int payload_size = 0;
+        if (socket->listener != NULL)
+                microtcp_flow_remove(&socket->listener->flows, (const struct sockaddr_in *) socket->cliaddr);
+        socket->handshake_deadline_us = 0;
+        socket->state = CLOSED;
+
+        free(socket->cliaddr);
+        socket->cliaddr = NULL;
 
-        socket->seq_number += payload_size + 1;
+        free(socket->servaddr);
+        socket->servaddr = NULL;
 
-        init_microtcp_segment(&sent_ack_segment, socket->seq_number, socket->ack_number, ACK_BIT, socket->curr_win_size, payload_size, NULL);
-        create_microtcp_bit_stream_segment(&sent_ack_segment, &bit_stream, &stream_len);
-        sendto(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, socket->cliaddr, sizeof(struct sockaddr));
+        recvbuf_release(socket);
 
-        socket->state = CLOSING_BY_PEER;
+        rtx_queue_free(&socket->rtx_queue);
+        connection_buffers_free(socket);
+}
 
-        socket->seq_number += payload_size + 1;
+static int active_close_start(microtcp_sock_t *const socket)
+{
+        /* Segments still batched go out before the FIN, whose reply is not coalesced with them. */
+        if (tx_flush(socket) < 0)
+                return -1;
+        if (socket->gro_enabled)
+                udp_gro_set(socket, false);
 
-        microtcp_segment_t sent_fin_ack_segment;
-        init_microtcp_segment(&sent_fin_ack_segment, socket->seq_number, socket->ack_number, FIN_BIT | ACK_BIT, socket->curr_win_size, payload_size, NULL);
-        create_microtcp_bit_stream_segment(&sent_fin_ack_segment, &bit_stream, &stream_len);
-        sendto(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, socket->cliaddr, sizeof(struct sockaddr));
+        socket->state = CLOSING_BY_HOST;
+        socket->fin_acked = false;
+        socket->fin_received = false;
+        socket->fin_retransmissions = 0;
+        socket->handshake_deadline_us = now_us() + socket->rto_us;
 
-        int len = sizeof(microtcp_segment_t);
-        microtcp_segment_t *recv_ack_segment;
-        stream_len = sizeof(microtcp_segment_t);
-        bit_stream = malloc(stream_len);
-        recvfrom(socket->sd, bit_stream, stream_len, NO_FLAGS_BITS, socket->cliaddr, &len);
-        extract_microtcp_bitstream(&recv_ack_segment, bit_stream, stream_len);
-        if ((recv_ack_segment->header.control & ACK_BIT) != ACK_BIT)
-        {
-                fprintf(stderr, "Error: microtcp_recv() failed, shutdown ACK bit was not valid.\n");
+        if (send_segment(socket, socket->seq_number, FIN_BIT | ACK_BIT, NULL, 0) < 0 || tx_flush(socket) < 0)
                 return -1;
+
+        return 0;
+}
+
+static int active_close_progress(microtcp_sock_t *const socket, bool wait)
+{
+        uint8_t *datagram;
+        microtcp_header_t header;
+
+        /* The FIN is only sent again on timeout, not for every other segment received. */
+        while (socket->state == CLOSING_BY_HOST)
+        {
+                uint64_t now = now_us();
+                if (now >= socket->handshake_deadline_us)
+                {
+                        /* Once the FIN is acknowledged, it is the peer's FIN-ACK that is waited for. */
+                        if (socket->fin_acked || socket->fin_retransmissions == MICROTCP_FIN_RETRIES)
+                        {
+                                active_close_finish(socket);
+                                microtcp_set_errno(CLOSE_TIMEOUT);
+                                return -1;
+                        }
+                        if (send_segment(socket, socket->seq_number, FIN_BIT | ACK_BIT, NULL, 0) < 0 || tx_flush(socket) < 0)
+                                return -1;
+                        socket->fin_retransmissions++;
+                        socket->rto_us *= 2;
+                        if (socket->rto_us > socket->rto_max_us)
+                                socket->rto_us = socket->rto_max_us;
+                        socket->handshake_deadline_us = now + socket->rto_us;
+                }
+
+                if (wait)
+                {
+                        int ready = wait_for_segment(socket, socket->handshake_deadline_us - now);
+                        if (ready < 0)
+                                return -1;
+                        if (ready == 0)
+                                continue;
+                }
+                if (receive_segment(socket, &datagram, &header, MSG_DONTWAIT) < 0)
+                {
+                        if (!wait && !rx_batch_pending(socket))
+                                return would_block();
+                        continue;
+                }
+
+                /* Window updates the server sent while reading the last of the data do not acknowledge the FIN. */
+                if ((header.control & ACK_BIT) != ACK_BIT || header.ack_number != (uint32_t) (socket->seq_number + 1))
+                        continue;
+                if (!socket->fin_acked)
+                {
+                        socket->fin_acked = true;
+                        socket->handshake_deadline_us = now + MICROTCP_FIN_WAIT_US;
+                }
+
+                /* The FIN-ACK acknowledges the FIN as well, when the ACK before it was lost. */
+                if ((header.control & FIN_BIT) == FIN_BIT)
+                {
+                        socket->seq_number += 1;
+                        socket->ack_number = header.seq_number + 1;
+                        send_segment(socket, socket->seq_number, ACK_BIT, NULL, 0);
+                        tx_flush(socket);
+                        active_close_finish(socket);
+                }
         }
 
-        socket->state = CLOSED;
+        return 0;
+}
 
-        free(socket->cliaddr);
-        socket->cliaddr = NULL;
+static void active_close_finish(microtcp_sock_t *const socket)
+{
+        socket->handshake_deadline_us = 0;
+        socket->state = CLOSED;
 
         free(socket->servaddr);
         socket->servaddr = NULL;
 
-        free(socket->recvbuf);
-        socket->recvbuf = NULL;
+        recvbuf_release(socket);
 
-        free(bit_stream);
-        return 0;
+        rtx_queue_free(&socket->rtx_queue);
+        connection_buffers_free(socket);
 }
 
 /* End   of definitions of inner working (helper) functions. */
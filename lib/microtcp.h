@@ -33,24 +33,78 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
 
 /*
  * Several useful constants
  */
-#define MICROTCP_ACK_TIMEOUT_US 200000         /* US = microseconds (letter 'u' is used to specify micro). */
+#define MICROTCP_ACK_TIMEOUT_US 200000         /* US = microseconds (letter 'u' is used to specify micro). Initial RTO. */
+#define MICROTCP_MIN_RTO_US 5000               /* Default lower bound of the adaptive retransmission timeout. */
+#define MICROTCP_MAX_RTO_US 60000000           /* Default upper bound of the adaptive retransmission timeout. */
+#define MICROTCP_FIN_RETRIES 4                 /* Times the FIN is sent again before the peer is given up on when closing. */
+#define MICROTCP_FIN_WAIT_US 60000000          /* Longest wait for the FIN of the peer once it has acknowledged ours. */
 #define MICROTCP_MSS 1400                      /* Maximum Segment Size (in bytes) of Data/Payload (headers not included). */
-#define MICROTCP_RECVBUF_LEN 8192              /* 8 KB buffer size. */
+#define MICROTCP_RECVBUF_LEN 8192              /* 8 KB buffer size. Initial and smallest size of recvbuf by default. */
+#define MICROTCP_RECVBUF_AUTOTUNE_MAX (4 * 1024 * 1024) /* Default upper bound of receive buffer auto-tuning. */
+#define MICROTCP_RECVBUF_SHRINK_RTTS 16        /* Consecutive RTTs the receive buffer must be four times too large before it shrinks. */
+#define MICROTCP_MAX_WSCALE 14                 /* Largest window scale shift, as in RFC 7323. */
+#define MICROTCP_MAX_RECVBUF_LEN ((size_t) UINT16_MAX << MICROTCP_MAX_WSCALE) /* Largest window that can be advertised. */
 #define MICROTCP_WIN_SIZE MICROTCP_RECVBUF_LEN /* 8KBytes. Seem small for window size. */
 #define MICROTCP_INIT_CWND (3 * MICROTCP_MSS)
 #define MICROTCP_INIT_SSTHRESH MICROTCP_WIN_SIZE
+#define MICROTCP_CC_STATE_WORDS 24             /* Private state of the congestion controller, in 64-bit words. */
+#define MICROTCP_PACING_BURST (2 * MICROTCP_MSS) /* Depth of the pacing token bucket in bytes. */
+#define MICROTCP_ACK_EVERY 2                   /* Full-sized segments acknowledged by a single ACK. */
+#define MICROTCP_DELACK_TIMEOUT_US 2000        /* Longest an ACK is delayed, well below MICROTCP_MIN_RTO_US. */
+#define MICROTCP_DUP_ACK_THRESHOLD 3           /* Duplicate ACKs that trigger a fast retransmit. */
+#define MICROTCP_SACK_BLOCKS 3                 /* SACK blocks carried in future_use0..2 of an ACK. */
+#define MICROTCP_OOO_RANGES 16                 /* Out-of-order ranges the receiver keeps track of. */
+#define MICROTCP_RTX_QUEUE_SLOTS 4096          /* Retransmission queue capacity in MSS-sized slots, must be a power of two. */
+#define MICROTCP_POOL_SLOTS 64                 /* Segment buffers in the pool of a connection, at most 64. */
+#define MICROTCP_GLOBAL_POOL_SLOTS 256         /* Segment buffers shared by all connections, used once their own pool runs out. */
+#define MICROTCP_TX_BATCH 32                   /* Segments handed to the kernel by a single sendmmsg(). */
+#define MICROTCP_RX_BATCH 32                   /* Datagrams taken from the kernel by a single recvmmsg(), at most MICROTCP_POOL_SLOTS. */
+#define MICROTCP_GRO_BATCH 4                   /* Datagrams of up to 64 KB coalesced by UDP GRO taken by a single recvmmsg(), at most MICROTCP_RX_BATCH. */
+#define MICROTCP_ENGINE_RING_LEN (256 * 1024) /* Bytes of each ring between an application thread and the engine, must be a power of two. */
 
 #define ACK_BIT (0b1 << 12)
 #define RST_BIT (0b1 << 13)
 #define SYN_BIT (0b1 << 14)
 #define FIN_BIT (0b1 << 15)
+#define MICROTCP_SACK_SHIFT_MASK 0xf /* Low bits of the control field of an ACK, the shift of its SACK blocks. */
 
 #define NO_FLAGS_BITS 0
 
+/*
+ * Events of microtcp_poll().
+ */
+#define MICROTCP_POLLIN (0b1 << 0)        /* Data can be read, or microtcp_recv() will return 0 as the peer has finished sending. */
+#define MICROTCP_POLLOUT (0b1 << 1)       /* microtcp_send() has room to queue data. */
+#define MICROTCP_POLLCONNECTED (0b1 << 2) /* The 3-way handshake has completed. */
+#define MICROTCP_POLLCLOSED (0b1 << 3)    /* The peer has finished sending, or the connection is shut down. Always reported. */
+
+/*
+ * Options carried in future_use0 of SYN and SYN-ACK segments. An option is
+ * in effect only if both peers set it.
+ */
+#define MICROTCP_OPT_SACK (0b1 << 0)   /* Selective acknowledgements. */
+#define MICROTCP_OPT_WSCALE (0b1 << 1) /* Window scaling, the sender's shift is carried in bits 8-15. */
+#define MICROTCP_OPT_WSCALE_OFFSET 8
+#define MICROTCP_OPT_CHECKSUM_OFFSET 16 /* Checksum algorithm asked for by the sender, in bits 16-23. */
+
+/**
+ * Segment checksum algorithms, negotiated at the 3-way handshake: the one
+ * both peers ask for, CRC-32 if they differ. SYN and SYN-ACK segments
+ * always carry a CRC-32.
+ */
+typedef enum
+{
+        MICROTCP_CHECKSUM_CRC32,  /* IEEE 802.3 CRC-32 of utils/crc32.h. */
+        MICROTCP_CHECKSUM_CRC32C, /* Castagnoli CRC-32C of utils/crc32c.h, with the crc32 instruction where available. */
+        MICROTCP_CHECKSUM_NONE    /* No checksum, for loopback and trusted links where the UDP checksum suffices. */
+} microtcp_checksum_t;
+
 /**
  * Possible states of the microTCP socket
  *
@@ -62,6 +116,8 @@ typedef enum
         READY,
         WARNING, /* Socket created, but soft errors occured. */
         LISTEN, /* After bind() the socket it ready for incoming connections. */
+        SYN_SENT, /* A non-blocking connect() is waiting for the SYN-ACK. */
+        SYN_RECEIVED, /* A non-blocking accept() is waiting for the final ACK of the handshake. */
         ESTABLISHED, /* After accept() the connection is established. */
         CLOSING_BY_PEER,
         CLOSING_BY_HOST,
@@ -69,6 +125,79 @@ typedef enum
         INVALID
 } mircotcp_state_t;
 
+/**
+ * Descriptor of a segment held in the retransmission queue.
+ */
+typedef struct
+{
+        uint64_t offset;        /**< Stream offset of the first byte stored in the slot */
+        uint16_t len;           /**< Bytes stored in the slot */
+        uint16_t transmissions; /**< Times the bytes from sent_offset on have been put on the wire */
+        uint64_t sent_us;       /**< Time of the last transmission, for RTT samples */
+        uint64_t sent_offset;   /**< Stream offset from which the bytes went out first at sent_us, earlier ones were sent before */
+        bool sacked;            /**< Selectively acknowledged by the peer */
+        uint32_t payload_crc;   /**< Checksum register after the bytes stored in the slot */
+} microtcp_rtx_segment_t;
+
+/**
+ * Per-connection retransmission queue. Slot i covers the stream offsets
+ * [i * MICROTCP_MSS, (i + 1) * MICROTCP_MSS) modulo the ring size, so the slot
+ * of any sequence number is found by arithmetic alone and a cumulative ACK
+ * releases a whole range by moving una. Stream offsets are 64-bit, the
+ * sequence number of offset 0 is iss.
+ */
+typedef struct
+{
+        microtcp_rtx_segment_t *segments; /**< Descriptor ring, MICROTCP_RTX_QUEUE_SLOTS entries */
+        uint8_t *data;                    /**< Payload store, MICROTCP_MSS bytes per slot */
+        uint32_t iss;                     /**< Sequence number of stream offset 0 */
+        uint64_t una;                     /**< First unacknowledged byte */
+        uint64_t nxt;                     /**< Next byte to be sent */
+        uint64_t high;                    /**< Highest byte ever sent plus one */
+        uint64_t end;                     /**< End of the queued data */
+} microtcp_rtx_queue_t;
+
+/**
+ * Per-connection pool of cache-aligned segment buffers, each large enough
+ * for a header and a full payload. See microtcp_pool.h.
+ */
+typedef struct
+{
+        uint8_t *slots;     /**< MICROTCP_POOL_SLOTS buffers of MICROTCP_POOL_SLOT_LEN bytes */
+        uint64_t free_mask; /**< Bit i is set while buffer i is free */
+} microtcp_pool_t;
+
+/**
+ * Connections of a listener by the address of their peer, an open addressing
+ * hash table probed a group of control bytes at a time. See microtcp_flow.h.
+ */
+typedef struct
+{
+        uint8_t *ctrl;                    /**< Control byte of each slot, followed by a copy of the first group */
+        struct microtcp_flow_slot *slots; /**< Keys and their connections, inline */
+        size_t capacity;                  /**< Slots, a power of two */
+        size_t count;                     /**< Entries in the table */
+        size_t growth_left;               /**< Empty slots that may still be filled before the table is rehashed */
+} microtcp_flow_table_t;
+
+struct microtcp_cc_ops; /* See microtcp_cc.h */
+struct microtcp_tx_batch; /* See microtcp.c */
+struct microtcp_rx_batch; /* See microtcp.c */
+struct microtcp_listener; /* See below */
+struct microtcp_engine; /* See below */
+struct microtcp_engine_link; /* See microtcp.c */
+struct microtcp_engine_flags; /* See microtcp.c */
+struct pollfd; /* See poll.h */
+
+/**
+ * Range [start, end) of sequence numbers.
+ */
+typedef struct
+{
+        uint32_t start;
+        uint32_t end;
+} microtcp_seq_range_t;
+
 /**
  * This is the microTCP socket structure. It holds all the necessary
  * information of each microTCP socket.
@@ -81,15 +210,81 @@ typedef struct
         mircotcp_state_t state; /**< The state of the microTCP socket */
         size_t init_win_size;   /**< The window size negotiated at the 3-way handshake */
         size_t curr_win_size;   /**< The current window size */
+        size_t peer_win_size;   /**< The last window size advertised by the peer */
 
         uint8_t *recvbuf;       /**< The *receive* buffer of the TCP
                                      connection. It is allocated during the connection establishment and
                                      is freed at the shutdown of the connection. This buffer is used
                                      to retrieve the data from the network. */
-        size_t buf_fill_level;  /**< Amount of data in the buffer */
+        size_t buf_fill_level;  /**< Amount of in-order data in the buffer */
+        size_t recvbuf_head;    /**< Position of the next byte to be delivered, recvbuf is used as a ring */
+        size_t recvbuf_len;     /**< Size of recvbuf, auto-tuned between the two bounds below, the initial size may be changed before connecting */
+        size_t recvbuf_min_len; /**< Lower bound of recvbuf_len, may be changed before connecting */
+        size_t recvbuf_max_len; /**< Upper bound of recvbuf_len, at most MICROTCP_MAX_RECVBUF_LEN, may be changed before connecting */
+        size_t recvbuf_reserved; /**< Address space mapped for recvbuf, recvbuf_max_len at connection setup, recvbuf is resized within it */
+        uint64_t rcv_rtt_us;    /**< Round-trip time estimated by the receiver, 0 until the first sample */
+        uint32_t rcv_rtt_seq;   /**< Sequence number whose arrival completes the current receiver RTT sample */
+        uint64_t rcv_rtt_start_us; /**< Start of the current receiver RTT sample, 0 if none is running */
+        size_t drained_bytes;   /**< Bytes the application read since drain_start_us */
+        uint64_t drain_start_us; /**< Start of the current drain rate measurement */
+        size_t shrink_target;   /**< Largest size estimated since the estimates fell to a quarter of recvbuf_len, 0 while they are higher */
+        uint8_t shrink_rtts;    /**< Consecutive measurements that asked for at most a quarter of recvbuf_len */
+        uint8_t rcv_wscale;     /**< Shift of the windows advertised to the peer, negotiated at the 3-way handshake */
+        uint8_t snd_wscale;     /**< Shift of the windows advertised by the peer, negotiated at the 3-way handshake */
+        microtcp_checksum_t checksum;      /**< Checksum algorithm to ask for, may be changed before connecting */
+        microtcp_checksum_t checksum_mode; /**< Checksum algorithm negotiated at the 3-way handshake */
 
         size_t cwnd;
         size_t ssthresh;
+        const struct microtcp_cc_ops *cc_ops;      /**< Congestion controller, see microtcp_set_congestion_control() */
+        uint64_t cc_state[MICROTCP_CC_STATE_WORDS]; /**< Private state of the congestion controller */
+        size_t dup_acks;        /**< Consecutive duplicate ACKs received */
+        bool in_recovery;       /**< In NewReno fast recovery */
+        uint64_t recover;       /**< Stream offset that ends fast recovery when acknowledged */
+
+        bool sack_enabled;      /**< Request SACK when connecting, may be changed before connecting */
+        bool sack_permitted;    /**< SACK was negotiated at the 3-way handshake */
+        uint64_t sack_high;     /**< End of the highest selectively acknowledged byte */
+        uint64_t sack_rtx_next; /**< Where the next search for an unacknowledged hole starts */
+
+        size_t ack_every;            /**< Full-sized segments acknowledged together, may be changed at any time */
+        uint64_t delack_timeout_us;  /**< Longest delay of an ACK, 0 acknowledges every segment right away, may be changed at any time */
+        size_t segments_unacked;     /**< Segments received since the last ACK was sent */
+        uint64_t delack_deadline_us; /**< When the pending ACK must be sent, 0 if none is pending */
+        size_t advertised_win;       /**< Window carried by the last ACK sent */
+        bool fin_received;           /**< The peer's FIN arrived while data was still waiting in recvbuf */
+
+        microtcp_seq_range_t ooo_ranges[MICROTCP_OOO_RANGES]; /**< Out-of-order data held in recvbuf, sorted */
+        size_t ooo_count;       /**< Number of out-of-order ranges */
+        size_t ooo_last;        /**< Range that received the most recent segment */
+
+        microtcp_rtx_queue_t rtx_queue; /**< Sent but unacknowledged data */
+        microtcp_pool_t pool;           /**< Segment buffers of the connection */
+        struct microtcp_tx_batch *tx_batch; /**< Segments waiting to be sent together, NULL sends each one right away */
+        bool gso_enabled;                   /**< Send runs of full-sized segments with UDP GSO, may be changed before connecting. Cleared if the kernel does not support it */
+        struct microtcp_rx_batch *rx_batch; /**< Datagrams received together and not processed yet */
+        bool gro_enabled;                   /**< Let the kernel coalesce received segments with UDP GRO, may be changed before connecting. Cleared if the kernel does not support it */
+        struct microtcp_listener *listener; /**< Listener that accepted the connection and routes its datagrams, NULL if it has a UDP socket of its own */
+        bool nonblocking;                   /**< Calls fail with WOULD_BLOCK and errno EAGAIN instead of waiting, see microtcp_poll(). May be changed at any time */
+        uint64_t handshake_deadline_us;     /**< When the SYN, SYN-ACK or FIN is sent again, or the peer is given up on when closing */
+        bool fin_acked;                     /**< The peer has acknowledged the FIN sent when closing */
+        size_t fin_retransmissions;         /**< Times the FIN has been sent again when closing, see MICROTCP_FIN_RETRIES */
+        struct microtcp_engine *engine;           /**< Engine that does the protocol work of the connection, NULL if the application's calls do, see microtcp_engine_attach() */
+        struct microtcp_engine_link *engine_link; /**< Rings shared with the engine, kept after a detach until the connection is shut down */
+
+        uint64_t srtt_us;         /**< Smoothed round-trip time, 0 until the first sample */
+        uint64_t rttvar_us;       /**< Round-trip time variation */
+        uint64_t rto_us;          /**< Current retransmission timeout, including backoff */
+        uint64_t rto_min_us;      /**< Lower bound of the retransmission timeout, may be changed before connecting */
+        uint64_t rto_max_us;      /**< Upper bound of the retransmission timeout, may be changed before connecting */
+        uint64_t rto_deadline_us; /**< Expiry time of the retransmission timer, 0 if not armed */
+
+        bool pacing_enabled;      /**< Space out transmissions instead of sending the window in bursts, may be changed at any time */
+        uint64_t max_pacing_rate; /**< Cap of the pacing rate in bytes per second, 0 for none, may be changed at any time */
+        uint64_t pacing_rate;     /**< Rate of the last paced transmission in bytes per second */
+        uint64_t pacing_tokens;   /**< Bytes that may be sent right away */
+        uint64_t pacing_last_us;  /**< Last refill of the token bucket */
+        uint64_t pacing_next_us;  /**< When the next segment may be sent, 0 if the sender is not held back by pacing */
 
         size_t seq_number; /**< Keep the state of the sequence number */ 
         size_t ack_number; /**< Keep the state of the ack number */
@@ -99,6 +294,9 @@ typedef struct
         uint64_t bytes_send;
         uint64_t bytes_received;
         uint64_t bytes_lost;
+        uint64_t checksum_failures; /**< Segments dropped because their checksum did not match */
+        uint64_t tx_syscalls;       /**< System calls that sent the packets_send segments, their ratio is the segments per call */
+        uint64_t rx_syscalls;       /**< recvmmsg() calls that returned the datagrams of established connections */
 
         struct sockaddr* servaddr;
         struct sockaddr* cliaddr;
@@ -137,14 +335,79 @@ typedef struct
 
 } microtcp_segment_t; /* MicroTCP packet. */
 
+/**
+ * SYN of a peer waiting in the backlog of a listener.
+ */
+typedef struct
+{
+        struct sockaddr_in peer;
+        microtcp_header_t header;
+} microtcp_pending_syn_t;
+
+/**
+ * A bound UDP port shared by many connections. Datagrams are routed to the
+ * connection of their peer, and the data of a connection the application is
+ * not blocked on is still buffered and acknowledged as it arrives. SYNs of
+ * new peers wait in the backlog until microtcp_listener_accept() takes them.
+ */
+typedef struct microtcp_listener
+{
+        int sd;                             /**< The UDP socket all the connections use */
+        microtcp_flow_table_t flows;        /**< Established and accepting connections by peer address */
+        microtcp_pending_syn_t *backlog;    /**< SYNs not accepted yet, oldest first, a ring */
+        size_t backlog_len;                 /**< Capacity of the backlog */
+        size_t backlog_head;                /**< Index of the oldest SYN */
+        size_t backlog_count;               /**< SYNs in the backlog */
+        microtcp_pool_t pool;               /**< Receive buffers */
+        struct microtcp_rx_batch *rx_batch; /**< Datagrams received together, before they are routed */
+        uint64_t rx_syscalls;               /**< recvmmsg() calls on the UDP socket */
+        uint64_t datagrams_dropped;         /**< Datagrams of unknown peers that were not a SYN, or found the backlog or their connection full */
+        uint64_t delack_deadline_us;        /**< Earliest delayed ACK deadline of the connections, 0 if none is pending */
+        struct microtcp_engine *engine;     /**< Engine the connections are attached to, NULL until one is */
+} microtcp_listener_t;
+
+/**
+ * Background thread that does the protocol work of a group of connections:
+ * it owns their UDP sockets, processes ACKs and arriving data, and runs the
+ * retransmission, delayed ACK and pacing timers, so none of it waits for
+ * the application to call in. Application threads exchange data with it
+ * through a pair of single-producer single-consumer rings per connection.
+ */
+typedef struct microtcp_engine
+{
+        pthread_t thread;                    /**< Thread that runs the engine */
+        int wake_fd;                         /**< eventfd written by application threads to wake the engine up */
+        struct microtcp_engine_flags *flags; /**< Flags shared with the thread */
+        bool running;                        /**< Between microtcp_engine_start() and microtcp_engine_stop() */
+        struct microtcp_engine_link **links; /**< Connections of the group, in the order they were attached */
+        size_t count;                        /**< Connections in links */
+        struct pollfd *fds;                  /**< UDP sockets of the group, each once, and wake_fd */
+        size_t nfds;                         /**< Entries in fds */
+        uint64_t rounds;                     /**< Passes over the connections */
+        uint64_t sleeps;                     /**< Passes after which the engine had to wait */
+} microtcp_engine_t;
+
 microtcp_sock_t microtcp_socket(int domain, int type, int protocol);
 
 int microtcp_bind(microtcp_sock_t *socket, const struct sockaddr *address, socklen_t address_len);
 
+/**
+ * Connects to a remote peer. A non-blocking socket sends the SYN and fails
+ * with WOULD_BLOCK, the handshake then completes as microtcp_poll() is
+ * called, which reports MICROTCP_POLLCONNECTED. Calling it again instead
+ * returns 0 once the connection is established.
+ *
+ * @param socket the socket structure
+ * @param address address of the peer
+ * @param address_len the length of the address structure
+ * @return 0 on success or -1 on failure
+ */
 int microtcp_connect(microtcp_sock_t *socket, const struct sockaddr *address, socklen_t address_len);
 
 /**
- * Blocks waiting for a new connection from a remote peer.
+ * Blocks waiting for a new connection from a remote peer. A non-blocking
+ * socket fails with WOULD_BLOCK until a SYN has arrived, and then while the
+ * handshake completes like it does for microtcp_connect().
  *
  * @param socket the socket structure
  * @param address pointer to store the address information of the connected peer
@@ -154,10 +417,164 @@ int microtcp_connect(microtcp_sock_t *socket, const struct sockaddr *address, so
  */
 int microtcp_accept(microtcp_sock_t *socket, struct sockaddr *address, socklen_t address_len);
 
+/**
+ * Closes a connection from the client side. Data left in flight is
+ * acknowledged first, then the FIN is sent again on timeout, with backoff,
+ * until the peer acknowledges it or MICROTCP_FIN_RETRIES is reached. A
+ * non-blocking socket fails with WOULD_BLOCK, the close then completes as
+ * microtcp_poll() is called, which reports MICROTCP_POLLCLOSED. Calling it
+ * again instead returns 0 once the connection is closed.
+ *
+ * @param socket the socket structure
+ * @param how SHUT_RDWR, SHUT_RD and SHUT_WR are not implemented
+ * @return 0 on success or -1 on failure, the connection is closed anyway
+ * when the peer does not finish closing in time
+ */
 int microtcp_shutdown(microtcp_sock_t *socket, int how);
+
+/**
+ * Binds a UDP socket that many connections share, one per peer.
+ *
+ * @param listener the listener structure
+ * @param address local address to bind to
+ * @param address_len the length of the address structure
+ * @param backlog SYNs of new peers kept until they are accepted, at least 1
+ * @return 0 on success or -1 on failure
+ */
+int microtcp_listen(microtcp_listener_t *listener, const struct sockaddr *address, socklen_t address_len, size_t backlog);
+
+/**
+ * Blocks until a SYN of a new peer is in the backlog and completes the
+ * handshake with it. Datagrams of the other connections that arrive in
+ * the meantime are routed to them. A non-blocking socket fails with
+ * WOULD_BLOCK while the backlog is empty, and then while the handshake
+ * completes like it does for microtcp_connect().
+ *
+ * @param listener the listener structure
+ * @param socket a socket returned by microtcp_socket(), its UDP socket is
+ * replaced by the listener's
+ * @param address pointer to store the address information of the connected peer
+ * @param address_len the length of the address structure.
+ * @return 0 on success or -1 on failure
+ */
+int microtcp_listener_accept(microtcp_listener_t *listener, microtcp_sock_t *socket, struct sockaddr *address, socklen_t address_len);
+
+/**
+ * Closes the UDP socket of a listener. Its connections must have been shut
+ * down before.
+ *
+ * @param listener the listener structure
+ */
+void microtcp_listener_close(microtcp_listener_t *listener);
+
+/**
+ * Selects the congestion control algorithm of the socket, resetting its
+ * congestion window. Sockets start with "reno".
+ *
+ * @param socket the socket structure
+ * @param name one of "reno", "cubic" or "bbr"
+ * @return 0 on success or -1 if there is no such algorithm
+ */
+int microtcp_set_congestion_control(microtcp_sock_t *socket, const char *name);
                                                                         /* TODO: what the fuck is this */
 ssize_t microtcp_send(microtcp_sock_t *socket, const void *buffer, size_t length, int flags);
 
 ssize_t microtcp_recv(microtcp_sock_t *socket, void *buffer, size_t length, int flags);
 
+/**
+ * Does the protocol work of the connection that is due, processing what
+ * has arrived and retransmitting, then waits until one of the events is
+ * ready. This is what drives a non-blocking connection: microtcp_send()
+ * queues as much as fits and returns before it is acknowledged, and
+ * microtcp_recv() returns what has arrived, both failing with WOULD_BLOCK
+ * when they can do nothing. Once microtcp_recv() has returned 0 on the
+ * server side, or microtcp_shutdown() has been called on the client side,
+ * the close handshake goes on here, and MICROTCP_POLLCLOSED is reported
+ * when it is closed.
+ *
+ * In an epoll loop, wait for socket->sd to be readable for at most
+ * microtcp_poll_timeout() and then call this with a timeout of 0.
+ * Connections of a listener share socket->sd, each of them is polled.
+ * A connection attached to an engine is only looked at, the engine does
+ * the protocol work, and the wait is for the engine to report progress.
+ *
+ * @param socket the socket structure
+ * @param events MICROTCP_POLL* events of interest
+ * @param timeout_us longest wait in microseconds, 0 not to wait and -1 to
+ * wait until an event is ready
+ * @return the events ready, 0 on timeout or -1 on failure
+ */
+int microtcp_poll(microtcp_sock_t *socket, int events, long timeout_us);
+
+/**
+ * @param socket the socket structure
+ * @return microseconds until microtcp_poll() has protocol work to do
+ * without anything arriving, like a retransmission or a delayed ACK, or
+ * -1 if there is none
+ */
+long microtcp_poll_timeout(const microtcp_sock_t *socket);
+
+/**
+ * Prepares an engine with an empty group of connections.
+ *
+ * @param engine the engine structure
+ * @return 0 on success or -1 on failure
+ */
+int microtcp_engine_init(microtcp_engine_t *engine);
+
+/**
+ * Adds an established connection to the group of an engine that has not
+ * been started. From then on microtcp_send() copies into the connection's
+ * send ring and returns, blocking only while the ring is full, and
+ * microtcp_recv() and microtcp_poll() read the receive ring, while the
+ * engine does everything else. Connections of a listener share its UDP
+ * socket, so they all go to the same engine and no more are accepted
+ * while it runs. A connection detached from an engine can be attached
+ * again once the data left in its receive ring has been read.
+ *
+ * @param engine the engine structure
+ * @param socket an established connection
+ * @return 0 on success or -1 on failure
+ */
+int microtcp_engine_attach(microtcp_engine_t *engine, microtcp_sock_t *socket);
+
+/**
+ * Starts the thread of an engine. The engine receives on the UDP socket of
+ * a listener for all its connections, so it fails with
+ * ENGINE_LISTENER_SPLIT unless every connection of the listener, accepting
+ * ones included, is attached to it.
+ *
+ * @param engine the engine structure
+ * @return 0 on success or -1 on failure
+ */
+int microtcp_engine_start(microtcp_engine_t *engine);
+
+/**
+ * Blocks until the peer has acknowledged all data of the connection's send
+ * ring and the engine lets go of the connection, the application's calls
+ * then do the protocol work again. Data left in the receive ring is still
+ * returned first. microtcp_shutdown() detaches by itself. Once the peer has
+ * finished sending and everything before its FIN has been read,
+ * microtcp_recv() returns 0 and the engine closes the connection on its
+ * own. A non-blocking socket fails with WOULD_BLOCK meanwhile, instead of
+ * waiting for the peer to acknowledge the FIN. Until then, a connection of
+ * a listener cannot be detached while the engine runs, as the engine keeps
+ * receiving on the shared UDP socket.
+ *
+ * @param socket a connection attached to a running engine
+ * @return 0 on success or -1 on failure
+ */
+int microtcp_engine_detach(microtcp_sock_t *socket);
+
+/**
+ * Stops the thread of an engine and releases it, along with the rings of
+ * its connections. The sockets that were attached must still exist. Those
+ * still attached are handed back to the application's calls, and the data
+ * left in the rings of all of them is dropped. Their listeners accept
+ * connections again.
+ *
+ * @param engine the engine structure
+ */
+void microtcp_engine_stop(microtcp_engine_t *engine);
+
 #endif /* LIB_MICROTCP_H_ */
\ No newline at end of file
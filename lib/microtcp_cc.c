@@ -0,0 +1,404 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+#include "microtcp_cc.h"
+
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* Start of declarations of inner working (helper) functions: */
+
+static inline uint64_t now_us(void)
+{
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static inline size_t flight_size(const microtcp_sock_t *const socket)
+{
+        return socket->rtx_queue.high - socket->rtx_queue.una;
+}
+
+/** @returns half the flight size, but at least two segments */
+static inline size_t half_flight_size(const microtcp_sock_t *const socket)
+{
+        size_t half = flight_size(socket) / 2;
+        return (half > 2 * MICROTCP_MSS) ? half : 2 * MICROTCP_MSS;
+}
+
+/* End   of declarations of inner working (helper) functions. */
+
+/*
+ * Reno (RFC 5681): slow start, then one MSS per round-trip, halving on loss.
+ */
+
+static void reno_init(microtcp_sock_t *socket)
+{
+        socket->cwnd = MICROTCP_INIT_CWND;
+        socket->ssthresh = MICROTCP_INIT_SSTHRESH;
+}
+
+static void reno_on_ack(microtcp_sock_t *socket, size_t acked_bytes)
+{
+        if (socket->cwnd < socket->ssthresh)
+                socket->cwnd += (acked_bytes < MICROTCP_MSS) ? acked_bytes : MICROTCP_MSS;
+        else
+                socket->cwnd += (MICROTCP_MSS * MICROTCP_MSS) / socket->cwnd + 1;
+}
+
+static void reno_on_loss(microtcp_sock_t *socket, microtcp_loss_t loss)
+{
+        socket->ssthresh = half_flight_size(socket);
+        socket->cwnd = (loss == MICROTCP_LOSS_FAST) ? socket->ssthresh : MICROTCP_MSS;
+}
+
+const struct microtcp_cc_ops microtcp_cc_reno = {
+    .name = "reno",
+    .init = reno_init,
+    .on_ack = reno_on_ack,
+    .on_loss = reno_on_loss,
+    .on_rtt_sample = NULL,
+    .pacing_rate = NULL,
+};
+
+/*
+ * CUBIC (RFC 8312): the window follows a cubic function of the time since
+ * the last loss, centred on the window where that loss happened, and never
+ * grows slower than Reno would.
+ */
+
+#define CUBIC_C 0.4
+#define CUBIC_BETA 0.7
+
+typedef struct
+{
+        double w_max;          /**< Window before the last reduction, in segments */
+        double k;              /**< Seconds until the cubic function reaches w_max */
+        double origin;         /**< Window the cubic function plateaus at, in segments */
+        double w_est;          /**< Reno-friendly window estimate, in segments */
+        uint64_t epoch_start_us; /**< Start of the current congestion avoidance epoch, 0 if none */
+} cubic_state_t;
+
+_Static_assert(sizeof(cubic_state_t) <= sizeof(((microtcp_sock_t *) 0)->cc_state), "cubic_state_t does not fit in cc_state");
+
+static void cubic_init(microtcp_sock_t *socket)
+{
+        cubic_state_t *cubic = (cubic_state_t *) socket->cc_state;
+        memset(cubic, 0, sizeof(*cubic));
+
+        socket->cwnd = MICROTCP_INIT_CWND;
+        socket->ssthresh = MICROTCP_INIT_SSTHRESH;
+}
+
+static void cubic_on_ack(microtcp_sock_t *socket, size_t acked_bytes)
+{
+        cubic_state_t *cubic = (cubic_state_t *) socket->cc_state;
+
+        if (socket->cwnd < socket->ssthresh)
+        {
+                socket->cwnd += (acked_bytes < MICROTCP_MSS) ? acked_bytes : MICROTCP_MSS;
+                return;
+        }
+
+        double cwnd = (double) socket->cwnd / MICROTCP_MSS;
+        uint64_t now = now_us();
+        if (cubic->epoch_start_us == 0)
+        {
+                cubic->epoch_start_us = now;
+                if (cwnd < cubic->w_max)
+                {
+                        cubic->k = cbrt((cubic->w_max - cwnd) / CUBIC_C);
+                        cubic->origin = cubic->w_max;
+                }
+                else
+                {
+                        cubic->k = 0;
+                        cubic->origin = cwnd;
+                }
+                cubic->w_est = cwnd;
+        }
+
+        /* Target one round-trip ahead, W(t) = C * (t - K)^3 + W_max. */
+        double t = (double) (now - cubic->epoch_start_us + socket->srtt_us) / 1e6 - cubic->k;
+        double target = cubic->origin + CUBIC_C * t * t * t;
+        if (target > 1.5 * cwnd)
+                target = 1.5 * cwnd;
+
+        double acked = (double) acked_bytes / MICROTCP_MSS;
+        cubic->w_est += 3 * (1 - CUBIC_BETA) / (1 + CUBIC_BETA) * acked / cwnd;
+        if (target < cubic->w_est)
+                target = cubic->w_est;
+
+        if (target > cwnd)
+                socket->cwnd += (size_t) ((target - cwnd) / cwnd * acked_bytes) + 1;
+        else
+                socket->cwnd += (size_t) (acked_bytes * MICROTCP_MSS / (100 * socket->cwnd)); /* Almost flat near w_max. */
+}
+
+static void cubic_on_loss(microtcp_sock_t *socket, microtcp_loss_t loss)
+{
+        cubic_state_t *cubic = (cubic_state_t *) socket->cc_state;
+        double cwnd = (double) socket->cwnd / MICROTCP_MSS;
+
+        /* Fast convergence: release bandwidth when losses come before reaching the previous w_max. */
+        cubic->w_max = (cwnd < cubic->w_max) ? cwnd * (1 + CUBIC_BETA) / 2 : cwnd;
+        cubic->epoch_start_us = 0;
+
+        size_t reduced = (size_t) (socket->cwnd * CUBIC_BETA);
+        socket->ssthresh = (reduced > 2 * MICROTCP_MSS) ? reduced : 2 * MICROTCP_MSS;
+        socket->cwnd = (loss == MICROTCP_LOSS_FAST) ? socket->ssthresh : MICROTCP_MSS;
+}
+
+const struct microtcp_cc_ops microtcp_cc_cubic = {
+    .name = "cubic",
+    .init = cubic_init,
+    .on_ack = cubic_on_ack,
+    .on_loss = cubic_on_loss,
+    .on_rtt_sample = NULL,
+    .pacing_rate = NULL,
+};
+
+/*
+ * BBR-style model based control: estimates the bottleneck bandwidth as the
+ * maximum delivery rate of the last BBR_BW_ROUNDS round-trips and the
+ * propagation delay as the minimum RTT of the last BBR_MIN_RTT_WINDOW_US,
+ * then paces at a multiple of the bandwidth and caps the flight to a
+ * multiple of their product. Loss is not taken as a congestion signal.
+ */
+
+#define BBR_UNIT 256 /* Fixed point unit of the gains. */
+#define BBR_HIGH_GAIN (BBR_UNIT * 2885 / 1000 + 1)
+#define BBR_DRAIN_GAIN (BBR_UNIT * 1000 / 2885)
+#define BBR_CWND_GAIN (BBR_UNIT * 2)
+#define BBR_BW_ROUNDS 10
+#define BBR_CYCLE_LEN 8
+#define BBR_FULL_BW_ROUNDS 3
+#define BBR_MIN_RTT_WINDOW_US 10000000
+#define BBR_PROBE_RTT_US 200000
+#define BBR_MIN_CWND (4 * MICROTCP_MSS)
+
+typedef enum
+{
+        BBR_STARTUP,
+        BBR_DRAIN,
+        BBR_PROBE_BW,
+        BBR_PROBE_RTT
+} bbr_mode_t;
+
+typedef struct
+{
+        uint64_t bw_samples[BBR_BW_ROUNDS]; /**< Delivery rate of the last rounds, bytes per second */
+        uint64_t btl_bw;             /**< Bottleneck bandwidth estimate, bytes per second */
+        uint64_t full_bw;            /**< Bandwidth at the last significant increase during startup */
+        uint64_t min_rtt_us;         /**< Propagation delay estimate, 0 until the first sample */
+        uint64_t min_rtt_stamp_us;   /**< When min_rtt_us was taken */
+        uint64_t round_start_us;     /**< Start of the current round, 0 if none */
+        uint64_t round_delivered;    /**< Bytes acknowledged during the current round */
+        uint64_t probe_rtt_done_us;  /**< End of the current PROBE_RTT */
+        uint32_t rounds;             /**< Completed rounds */
+        uint16_t pacing_gain;        /**< In BBR_UNIT */
+        uint16_t cwnd_gain;          /**< In BBR_UNIT */
+        uint8_t mode;                /**< bbr_mode_t */
+        uint8_t prior_mode;          /**< Mode to return to after PROBE_RTT */
+        uint8_t full_bw_rounds;      /**< Rounds without significant bandwidth growth */
+        uint8_t cycle_index;         /**< Position in the PROBE_BW gain cycle */
+} bbr_state_t;
+
+_Static_assert(sizeof(bbr_state_t) <= sizeof(((microtcp_sock_t *) 0)->cc_state), "bbr_state_t does not fit in cc_state");
+
+static const uint16_t bbr_cycle_gains[BBR_CYCLE_LEN] = {
+    BBR_UNIT * 5 / 4, BBR_UNIT * 3 / 4, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT};
+
+static uint64_t bbr_bdp(const bbr_state_t *const bbr, uint32_t gain)
+{
+        uint64_t bdp = bbr->btl_bw * bbr->min_rtt_us / 1000000 * gain / BBR_UNIT;
+        return (bdp > BBR_MIN_CWND) ? bdp : BBR_MIN_CWND;
+}
+
+static void bbr_set_mode(bbr_state_t *const bbr, bbr_mode_t mode)
+{
+        bbr->mode = mode;
+        switch (mode)
+        {
+        case BBR_STARTUP:
+                bbr->pacing_gain = BBR_HIGH_GAIN;
+                bbr->cwnd_gain = BBR_HIGH_GAIN;
+                break;
+        case BBR_DRAIN:
+                bbr->pacing_gain = BBR_DRAIN_GAIN;
+                bbr->cwnd_gain = BBR_HIGH_GAIN;
+                break;
+        case BBR_PROBE_BW:
+                bbr->cycle_index = 2;
+                bbr->pacing_gain = bbr_cycle_gains[bbr->cycle_index];
+                bbr->cwnd_gain = BBR_CWND_GAIN;
+                break;
+        case BBR_PROBE_RTT:
+                bbr->pacing_gain = BBR_UNIT;
+                bbr->cwnd_gain = BBR_UNIT;
+                break;
+        }
+}
+
+static void bbr_init(microtcp_sock_t *socket)
+{
+        bbr_state_t *bbr = (bbr_state_t *) socket->cc_state;
+        memset(bbr, 0, sizeof(*bbr));
+        bbr_set_mode(bbr, BBR_STARTUP);
+
+        socket->cwnd = MICROTCP_INIT_CWND;
+        socket->ssthresh = SIZE_MAX;
+}
+
+/** Closes a round once a min RTT has passed and advances the state machine. */
+static void bbr_end_round(microtcp_sock_t *socket, bbr_state_t *const bbr, uint64_t now)
+{
+        uint64_t elapsed = now - bbr->round_start_us;
+        bbr->bw_samples[bbr->rounds % BBR_BW_ROUNDS] = bbr->round_delivered * 1000000 / elapsed;
+        bbr->rounds++;
+        bbr->round_start_us = now;
+        bbr->round_delivered = 0;
+
+        bbr->btl_bw = 0;
+        for (size_t i = 0; i < BBR_BW_ROUNDS; i++)
+                if (bbr->bw_samples[i] > bbr->btl_bw)
+                        bbr->btl_bw = bbr->bw_samples[i];
+
+        switch (bbr->mode)
+        {
+        case BBR_STARTUP:
+                /* The pipe is full once bandwidth grows less than 25% for a few rounds. */
+                if (bbr->btl_bw >= bbr->full_bw * 5 / 4)
+                {
+                        bbr->full_bw = bbr->btl_bw;
+                        bbr->full_bw_rounds = 0;
+                }
+                else if (++bbr->full_bw_rounds >= BBR_FULL_BW_ROUNDS)
+                {
+                        bbr_set_mode(bbr, BBR_DRAIN);
+                }
+                break;
+        case BBR_DRAIN:
+                if (flight_size(socket) <= bbr_bdp(bbr, BBR_UNIT))
+                        bbr_set_mode(bbr, BBR_PROBE_BW);
+                break;
+        case BBR_PROBE_BW:
+                bbr->cycle_index = (bbr->cycle_index + 1) % BBR_CYCLE_LEN;
+                bbr->pacing_gain = bbr_cycle_gains[bbr->cycle_index];
+                break;
+        case BBR_PROBE_RTT:
+                if (now >= bbr->probe_rtt_done_us)
+                {
+                        bbr->min_rtt_stamp_us = now;
+                        bbr_set_mode(bbr, (bbr_mode_t) bbr->prior_mode);
+                }
+                break;
+        }
+}
+
+static void bbr_on_ack(microtcp_sock_t *socket, size_t acked_bytes)
+{
+        bbr_state_t *bbr = (bbr_state_t *) socket->cc_state;
+        uint64_t now = now_us();
+
+        bbr->round_delivered += acked_bytes;
+        if (bbr->round_start_us == 0)
+                bbr->round_start_us = now;
+        else if (bbr->min_rtt_us != 0 && now - bbr->round_start_us >= bbr->min_rtt_us)
+                bbr_end_round(socket, bbr, now);
+
+        /* An expired min RTT is refreshed by briefly draining the queue. */
+        if (bbr->mode != BBR_PROBE_RTT && bbr->min_rtt_us != 0 && now - bbr->min_rtt_stamp_us > BBR_MIN_RTT_WINDOW_US)
+        {
+                bbr->prior_mode = bbr->mode;
+                bbr->probe_rtt_done_us = now + BBR_PROBE_RTT_US;
+                bbr_set_mode(bbr, BBR_PROBE_RTT);
+        }
+
+        if (bbr->btl_bw == 0)
+        {
+                socket->cwnd += acked_bytes; /* No model yet, grow like slow start. */
+                return;
+        }
+
+        uint64_t target = bbr_bdp(bbr, bbr->cwnd_gain);
+        if (bbr->mode == BBR_PROBE_RTT)
+                socket->cwnd = BBR_MIN_CWND;
+        else if (bbr->mode == BBR_STARTUP || socket->cwnd + acked_bytes < target)
+                socket->cwnd += acked_bytes;
+        else
+                socket->cwnd = target;
+}
+
+static void bbr_on_loss(microtcp_sock_t *socket, microtcp_loss_t loss)
+{
+        /* Recovery deflates cwnd back to ssthresh, i.e. to where the model had it. */
+        socket->ssthresh = socket->cwnd;
+        if (loss == MICROTCP_LOSS_TIMEOUT)
+                socket->cwnd = MICROTCP_MSS;
+}
+
+static void bbr_on_rtt_sample(microtcp_sock_t *socket, uint64_t rtt_us)
+{
+        bbr_state_t *bbr = (bbr_state_t *) socket->cc_state;
+        if (bbr->min_rtt_us == 0 || rtt_us <= bbr->min_rtt_us || now_us() - bbr->min_rtt_stamp_us > BBR_MIN_RTT_WINDOW_US)
+        {
+                bbr->min_rtt_us = (rtt_us > 0) ? rtt_us : 1;
+                bbr->min_rtt_stamp_us = now_us();
+        }
+}
+
+static uint64_t bbr_pacing_rate(const microtcp_sock_t *socket)
+{
+        const bbr_state_t *bbr = (const bbr_state_t *) socket->cc_state;
+        return bbr->btl_bw * bbr->pacing_gain / BBR_UNIT;
+}
+
+const struct microtcp_cc_ops microtcp_cc_bbr = {
+    .name = "bbr",
+    .init = bbr_init,
+    .on_ack = bbr_on_ack,
+    .on_loss = bbr_on_loss,
+    .on_rtt_sample = bbr_on_rtt_sample,
+    .pacing_rate = bbr_pacing_rate,
+};
+
+const struct microtcp_cc_ops *microtcp_cc_find(const char *name)
+{
+        static const struct microtcp_cc_ops *const available[] = {&microtcp_cc_reno, &microtcp_cc_cubic, &microtcp_cc_bbr};
+
+        if (name == NULL)
+                return NULL;
+        for (size_t i = 0; i < sizeof(available) / sizeof(available[0]); i++)
+                if (strcmp(available[i]->name, name) == 0)
+                        return available[i];
+
+        return NULL;
+}
@@ -0,0 +1,79 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+#ifndef LIB_MICROTCP_CC_H_
+#define LIB_MICROTCP_CC_H_
+
+#include "microtcp.h"
+
+/**
+ * Kinds of loss reported to a congestion controller.
+ */
+typedef enum
+{
+        MICROTCP_LOSS_FAST,   /* Triple duplicate ACK, fast recovery follows. */
+        MICROTCP_LOSS_TIMEOUT /* Retransmission timeout, the flight is considered lost. */
+} microtcp_loss_t;
+
+/**
+ * Congestion control operations. A controller keeps its private state in
+ * the cc_state words of the socket and owns cwnd and ssthresh, with the
+ * exception of NewReno window inflation/deflation during fast recovery.
+ */
+struct microtcp_cc_ops
+{
+        const char *name;
+
+        /** Resets the controller state and sets the initial cwnd/ssthresh. */
+        void (*init)(microtcp_sock_t *socket);
+
+        /** New data was cumulatively acknowledged outside of fast recovery. */
+        void (*on_ack)(microtcp_sock_t *socket, size_t acked_bytes);
+
+        /** A loss was detected, ssthresh and cwnd must be reduced as the controller sees fit. */
+        void (*on_loss)(microtcp_sock_t *socket, microtcp_loss_t loss);
+
+        /** A valid (Karn's rule) round-trip time sample was taken. May be NULL. */
+        void (*on_rtt_sample)(microtcp_sock_t *socket, uint64_t rtt_us);
+
+        /** @returns the rate in bytes per second segments should be paced at, 0 to let the sender derive it. May be NULL. */
+        uint64_t (*pacing_rate)(const microtcp_sock_t *socket);
+};
+
+extern const struct microtcp_cc_ops microtcp_cc_reno;
+extern const struct microtcp_cc_ops microtcp_cc_cubic;
+extern const struct microtcp_cc_ops microtcp_cc_bbr;
+
+/**
+ * @brief Looks up a congestion controller by name
+ * @param name name of the controller, e.g. "reno", "cubic" or "bbr"
+ * @returns the controller operations, NULL if there is no such controller
+ */
+const struct microtcp_cc_ops *microtcp_cc_find(const char *name);
+
+#endif /* LIB_MICROTCP_CC_H_ */
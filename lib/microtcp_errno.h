@@ -15,6 +15,7 @@ enum MICROTCP_ERRNO
     NULL_POINTER_ARGUMENT,
     MALLOC_FAILED,
     SOCKET_STATE_NOT_READY,
+    SOCKET_STATE_NOT_ESTABLISHED,
     TIMEOUT_SET_FAILED,
     INVALID_IP_VERSION,
     BITSTREAM_CREATION_FAILED,
@@ -24,8 +25,22 @@ enum MICROTCP_ERRNO
     ACK_PACKET_EXPECTED,
     ACK_NUMBER_MISMATCH,
     HANDSHAKE_FAILED,
+    CLOSE_TIMEOUT,
     SENDTO_FAILED,
-    RECVFROM_CORRUPTED
+    UNKNOWN_CONGESTION_CONTROL,
+    RECVFROM_FAILED,
+    RECVFROM_CORRUPTED,
+    INVALID_RECVBUF_LEN,
+    CHECKSUM_MISMATCH,
+    BUFFER_POOL_EXHAUSTED,
+    BIND_FAILED,
+    SEGMENT_FOR_OTHER_CONNECTION,
+    WOULD_BLOCK,
+    ENGINE_RUNNING,
+    ENGINE_ATTACHED,
+    ENGINE_FAILED,
+    ENGINE_LISTENER_SPLIT,
+    INVALID_ARGUMENT
 };
 
 enum MICROTCP_ERRNO MICRO_ERRNO = ALL_GOOD;
@@ -38,7 +53,7 @@ static void microtcp_set_errno(enum MICROTCP_ERRNO errno_, const char *function_
     switch (errno_)
     {
     case NULL_POINTER_ARGUMENT:
-        "NULL pointer was given as argument.";
+        error_message = "NULL pointer was given as argument.";
         break;
     case MALLOC_FAILED:
         error_message = "Memory allocation failed.";
@@ -46,6 +61,9 @@ static void microtcp_set_errno(enum MICROTCP_ERRNO errno_, const char *function_
     case SOCKET_STATE_NOT_READY:
         error_message = "Socket state is not in ready state.";
         break;
+    case SOCKET_STATE_NOT_ESTABLISHED:
+        error_message = "Socket state is not in established state.";
+        break;
     case TIMEOUT_SET_FAILED:
         error_message = "Setting timeout in recvfrom() failed.";
         break;
@@ -70,12 +88,54 @@ static void microtcp_set_errno(enum MICROTCP_ERRNO errno_, const char *function_
     case HANDSHAKE_FAILED:
         error_message = "Three-way handshake failed between server and client.";
         break;
+    case CLOSE_TIMEOUT:
+        error_message = "The peer did not finish closing the connection in time, it was closed anyway.";
+        break;
     case SENDTO_FAILED:
         error_message = "Sendind bit-stream with UDP::sendto() failed.";
         break;
+    case UNKNOWN_CONGESTION_CONTROL:
+        error_message = "No congestion control algorithm with the given name.";
+        break;
+    case RECVFROM_FAILED:
+        error_message = "Receiving bit-stream with UDP::recvfrom() failed.";
+        break;
     case RECVFROM_CORRUPTED:
         error_message = "UDP::recvfrom returned corrupted data.";
         break;
+    case INVALID_RECVBUF_LEN:
+        error_message = "Receive buffer bounds are out of order, below MSS or above the largest scaled window.";
+        break;
+    case CHECKSUM_MISMATCH:
+        error_message = "Segment checksum does not match its contents.";
+        break;
+    case BUFFER_POOL_EXHAUSTED:
+        error_message = "No segment buffer left in the connection's pool or the shared pool.";
+        break;
+    case BIND_FAILED:
+        error_message = "Binding the UDP socket failed.";
+        break;
+    case SEGMENT_FOR_OTHER_CONNECTION:
+        error_message = "The datagrams received were routed to other connections of the listener.";
+        break;
+    case WOULD_BLOCK:
+        error_message = "The operation would block a non-blocking socket.";
+        break;
+    case ENGINE_RUNNING:
+        error_message = "The connections of a running engine cannot change.";
+        break;
+    case ENGINE_ATTACHED:
+        error_message = "The connection is already attached to an engine.";
+        break;
+    case ENGINE_FAILED:
+        error_message = "The engine thread or its eventfd could not be created.";
+        break;
+    case ENGINE_LISTENER_SPLIT:
+        error_message = "The connections of a listener are not all attached to the same engine.";
+        break;
+    case INVALID_ARGUMENT:
+        error_message = "An argument is out of its valid range.";
+        break;
     default:
         error_message = "Unknown microtcp error number (default).";
         break;
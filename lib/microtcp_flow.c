@@ -0,0 +1,331 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+#include "microtcp_flow.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/*
+ * Connections are keyed by the address and port of the peer, the local
+ * address and port being those of the listener. The table is open
+ * addressing with the layout of a Swiss table: every slot has a control
+ * byte that is either empty, deleted, or holds 7 bits of the hash of its
+ * key. A lookup compares a whole group of control bytes against those 7
+ * bits at once, and only reads the keys of the slots that match, which
+ * sit inline next to their connection. The probe ends at the first group
+ * with an empty slot. At most 7/8 of the slots are filled, past that the
+ * table is rehashed, doubling it unless deleted slots were taking the room.
+ */
+
+#define FLOW_GROUP_WIDTH 16
+#define FLOW_CTRL_EMPTY 0x80
+#define FLOW_CTRL_DELETED 0xfe
+#define FLOW_MIN_CAPACITY 16
+
+struct microtcp_flow_slot
+{
+        uint64_t key;
+        microtcp_sock_t *socket;
+};
+
+/*
+ * Masks of the slots of a group whose control byte matches. The slot of a
+ * set bit is its index shifted right by FLOW_LANE_SHIFT, NEON produces a
+ * nibble per byte and only its top bit is kept.
+ */
+#if defined(__SSE2__)
+
+#define FLOW_LANE_SHIFT 0
+
+static inline uint64_t flow_group_match(const uint8_t *ctrl, uint8_t h2)
+{
+        __m128i group = _mm_loadu_si128((const __m128i *) ctrl);
+        return (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+}
+
+static inline uint64_t flow_group_free(const uint8_t *ctrl)
+{
+        /* Empty and deleted slots are the ones with the top bit set. */
+        return (uint16_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) ctrl));
+}
+
+#elif defined(__aarch64__)
+
+#define FLOW_LANE_SHIFT 2
+
+static inline uint64_t flow_group_mask(uint8x16_t lanes)
+{
+        uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL;
+}
+
+static inline uint64_t flow_group_match(const uint8_t *ctrl, uint8_t h2)
+{
+        return flow_group_mask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(h2)));
+}
+
+static inline uint64_t flow_group_free(const uint8_t *ctrl)
+{
+        return flow_group_mask(vtstq_u8(vld1q_u8(ctrl), vdupq_n_u8(0x80)));
+}
+
+#else
+
+#define FLOW_LANE_SHIFT 0
+
+static inline uint64_t flow_group_match(const uint8_t *ctrl, uint8_t h2)
+{
+        uint64_t mask = 0;
+        for (int i = 0; i < FLOW_GROUP_WIDTH; i++)
+                mask |= (uint64_t) (ctrl[i] == h2) << i;
+        return mask;
+}
+
+static inline uint64_t flow_group_free(const uint8_t *ctrl)
+{
+        uint64_t mask = 0;
+        for (int i = 0; i < FLOW_GROUP_WIDTH; i++)
+                mask |= (uint64_t) (ctrl[i] >> 7) << i;
+        return mask;
+}
+
+#endif
+
+static inline uint64_t flow_group_empty(const uint8_t *ctrl)
+{
+        return flow_group_match(ctrl, FLOW_CTRL_EMPTY);
+}
+
+static inline size_t flow_lane(uint64_t mask)
+{
+        return __builtin_ctzll(mask) >> FLOW_LANE_SHIFT;
+}
+
+static inline size_t flow_lanes_leading(uint64_t mask)
+{
+        return (__builtin_clzll(mask) - (64 - (FLOW_GROUP_WIDTH << FLOW_LANE_SHIFT))) >> FLOW_LANE_SHIFT;
+}
+
+static inline uint64_t flow_key(const struct sockaddr_in *peer)
+{
+        return (uint64_t) peer->sin_addr.s_addr << 16 | peer->sin_port;
+}
+
+/* Every bit of the key must reach the low bits, which pick the slot, and the 7 control bits. */
+static inline uint64_t flow_hash(uint64_t key)
+{
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return key;
+}
+
+static inline void flow_set_ctrl(microtcp_flow_table_t *table, size_t slot, uint8_t ctrl)
+{
+        table->ctrl[slot] = ctrl;
+        /* Groups are loaded from any slot, those starting near the end read the copy of the first group. */
+        if (slot < FLOW_GROUP_WIDTH)
+                table->ctrl[table->capacity + slot] = ctrl;
+}
+
+/**
+ * @brief Finds the first empty or deleted slot in the probe sequence of a hash
+ * @returns its index, the table always has one
+ */
+static size_t flow_find_free(const microtcp_flow_table_t *table, uint64_t hash)
+{
+        size_t mask = table->capacity - 1;
+        size_t pos = (hash >> 7) & mask;
+        for (size_t step = FLOW_GROUP_WIDTH;; step += FLOW_GROUP_WIDTH)
+        {
+                uint64_t free_slots = flow_group_free(table->ctrl + pos);
+                if (free_slots != 0)
+                        return (pos + flow_lane(free_slots)) & mask;
+                pos = (pos + step) & mask;
+        }
+}
+
+/**
+ * @brief Finds the slot of a key
+ * @returns its index, capacity if the key is not in the table
+ */
+static size_t flow_find(const microtcp_flow_table_t *table, uint64_t key)
+{
+        uint64_t hash = flow_hash(key);
+        uint8_t h2 = hash & 0x7f;
+        size_t mask = table->capacity - 1;
+        size_t pos = (hash >> 7) & mask;
+
+        /* Most keys sit within a few slots of where their probe starts, so the slot is fetched
+         * from memory along with the control bytes rather than after them. */
+        __builtin_prefetch(&table->slots[pos]);
+
+        /* Triangular steps of whole groups visit every group of a power of two table. */
+        for (size_t step = FLOW_GROUP_WIDTH;; step += FLOW_GROUP_WIDTH)
+        {
+                const uint8_t *group = table->ctrl + pos;
+                for (uint64_t match = flow_group_match(group, h2); match != 0; match &= match - 1)
+                {
+                        size_t slot = (pos + flow_lane(match)) & mask;
+                        if (table->slots[slot].key == key)
+                                return slot;
+                }
+                if (flow_group_empty(group) != 0)
+                        return table->capacity;
+                pos = (pos + step) & mask;
+        }
+}
+
+static int flow_resize(microtcp_flow_table_t *table, size_t capacity)
+{
+        /* The slots and their control bytes are a single allocation. */
+        struct microtcp_flow_slot *slots = malloc(capacity * sizeof(struct microtcp_flow_slot) + capacity + FLOW_GROUP_WIDTH);
+        if (slots == NULL)
+                return -1;
+
+        microtcp_flow_table_t resized = {
+                .ctrl = (uint8_t *) (slots + capacity),
+                .slots = slots,
+                .capacity = capacity,
+                .count = table->count,
+                .growth_left = capacity - capacity / 8 - table->count,
+        };
+        memset(resized.ctrl, FLOW_CTRL_EMPTY, capacity + FLOW_GROUP_WIDTH);
+
+        for (size_t i = 0; i < table->capacity; i++)
+        {
+                if (table->ctrl[i] & 0x80)
+                        continue;
+                uint64_t hash = flow_hash(table->slots[i].key);
+                size_t slot = flow_find_free(&resized, hash);
+                flow_set_ctrl(&resized, slot, hash & 0x7f);
+                resized.slots[slot] = table->slots[i];
+        }
+        free(table->slots);
+        *table = resized;
+
+        return 0;
+}
+
+int microtcp_flow_init(microtcp_flow_table_t *table, size_t capacity)
+{
+        /* Room for capacity entries within the 7/8 load factor. */
+        size_t slots = FLOW_MIN_CAPACITY;
+        while (slots - slots / 8 < capacity)
+                slots <<= 1;
+
+        table->ctrl = NULL;
+        table->slots = NULL;
+        table->capacity = 0;
+        table->count = 0;
+        table->growth_left = 0;
+        return flow_resize(table, slots);
+}
+
+void microtcp_flow_free(microtcp_flow_table_t *table)
+{
+        free(table->slots);
+        table->ctrl = NULL;
+        table->slots = NULL;
+        table->capacity = 0;
+        table->count = 0;
+        table->growth_left = 0;
+}
+
+microtcp_sock_t *microtcp_flow_lookup(const microtcp_flow_table_t *table, const struct sockaddr_in *peer)
+{
+        size_t slot = flow_find(table, flow_key(peer));
+        return (slot < table->capacity) ? table->slots[slot].socket : NULL;
+}
+
+int microtcp_flow_insert(microtcp_flow_table_t *table, const struct sockaddr_in *peer, microtcp_sock_t *socket)
+{
+        uint64_t key = flow_key(peer);
+        size_t slot = flow_find(table, key);
+        if (slot < table->capacity)
+        {
+                table->slots[slot].socket = socket;
+                return 0;
+        }
+
+        uint64_t hash = flow_hash(key);
+        slot = flow_find_free(table, hash);
+        /* Filling an empty slot past the load factor rehashes first. The table only doubles when the
+         * entries need the room, otherwise dropping the deleted slots is enough. */
+        if (table->growth_left == 0 && table->ctrl[slot] == FLOW_CTRL_EMPTY)
+        {
+                size_t capacity = (table->count + 1 > table->capacity / 2) ? table->capacity << 1 : table->capacity;
+                if (flow_resize(table, capacity) < 0)
+                        return -1;
+                slot = flow_find_free(table, hash);
+        }
+
+        if (table->ctrl[slot] == FLOW_CTRL_EMPTY)
+                table->growth_left--;
+        flow_set_ctrl(table, slot, hash & 0x7f);
+        table->slots[slot].key = key;
+        table->slots[slot].socket = socket;
+        table->count++;
+
+        return 0;
+}
+
+void microtcp_flow_remove(microtcp_flow_table_t *table, const struct sockaddr_in *peer)
+{
+        size_t slot = flow_find(table, flow_key(peer));
+        if (slot == table->capacity)
+                return;
+
+        /* If every group that covers the slot also has an empty one, no probe ever went past it
+         * and it can be emptied again instead of being marked deleted. */
+        uint64_t empty_after = flow_group_empty(table->ctrl + slot);
+        uint64_t empty_before = flow_group_empty(table->ctrl + ((slot - FLOW_GROUP_WIDTH) & (table->capacity - 1)));
+        bool empty_around = empty_after != 0 && empty_before != 0 &&
+                            flow_lane(empty_after) + flow_lanes_leading(empty_before) < FLOW_GROUP_WIDTH;
+        flow_set_ctrl(table, slot, empty_around ? FLOW_CTRL_EMPTY : FLOW_CTRL_DELETED);
+        if (empty_around)
+                table->growth_left++;
+        table->count--;
+}
+
+microtcp_sock_t *microtcp_flow_next(const microtcp_flow_table_t *table, size_t *slot)
+{
+        for (; *slot < table->capacity; (*slot)++)
+        {
+                if ((table->ctrl[*slot] & 0x80) == 0)
+                        return table->slots[(*slot)++].socket;
+        }
+        return NULL;
+}
@@ -0,0 +1,80 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+#ifndef LIB_MICROTCP_FLOW_H_
+#define LIB_MICROTCP_FLOW_H_
+
+#include "microtcp.h"
+
+/**
+ * @brief Allocates an empty flow table
+ * @param table table to initialize
+ * @param capacity connections the table is sized for, it grows beyond that as needed
+ * @returns 0 on success, -1 if the allocation failed
+ */
+int microtcp_flow_init(microtcp_flow_table_t *table, size_t capacity);
+
+/**
+ * @brief Releases a flow table, the connections in it are left untouched
+ * @param table table to release
+ */
+void microtcp_flow_free(microtcp_flow_table_t *table);
+
+/**
+ * @brief Looks up the connection of a peer
+ * @param table flow table
+ * @param peer address of the peer
+ * @returns the connection, NULL if the peer has none
+ */
+microtcp_sock_t *microtcp_flow_lookup(const microtcp_flow_table_t *table, const struct sockaddr_in *peer);
+
+/**
+ * @brief Adds the connection of a peer, replacing any it had
+ * @param table flow table
+ * @param peer address of the peer
+ * @param socket connection of the peer
+ * @returns 0 on success, -1 if the allocation failed
+ */
+int microtcp_flow_insert(microtcp_flow_table_t *table, const struct sockaddr_in *peer, microtcp_sock_t *socket);
+
+/**
+ * @brief Removes the connection of a peer, if it has one
+ * @param table flow table
+ * @param peer address of the peer
+ */
+void microtcp_flow_remove(microtcp_flow_table_t *table, const struct sockaddr_in *peer);
+
+/**
+ * @brief Iterates over the connections in the table, in no particular order
+ * @param table flow table
+ * @param slot position of the iteration, 0 to start, advanced past each connection returned
+ * @returns the next connection, NULL after the last one
+ */
+microtcp_sock_t *microtcp_flow_next(const microtcp_flow_table_t *table, size_t *slot);
+
+#endif /* LIB_MICROTCP_FLOW_H_ */
@@ -0,0 +1,116 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+#include "microtcp_pool.h"
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/*
+ * A connection owns its pool, so its buffers are tracked by a plain bitmap.
+ * The shared pool may be used by connections of different threads: its free
+ * buffers form a lock-free stack of slot indices, whose top carries a tag
+ * that changes on every update so that a stale compare-and-swap fails (ABA).
+ * Slots that were never handed out are taken in order, so the stack needs
+ * no initialization.
+ */
+
+#define POOL_ALL_FREE (UINT64_MAX >> (64 - MICROTCP_POOL_SLOTS))
+#define GLOBAL_EMPTY 0 /* Stack entries are slot index + 1. */
+
+_Static_assert(MICROTCP_POOL_SLOTS > 0 && MICROTCP_POOL_SLOTS <= 64, "MICROTCP_POOL_SLOTS must be in [1, 64]");
+
+static uint8_t global_slots[MICROTCP_GLOBAL_POOL_SLOTS][MICROTCP_POOL_SLOT_LEN] __attribute__((aligned(MICROTCP_CACHE_LINE)));
+static _Atomic uint32_t global_next[MICROTCP_GLOBAL_POOL_SLOTS]; /**< Entry below each free slot on the stack */
+static _Atomic uint64_t global_top = GLOBAL_EMPTY;              /**< Tag in the upper half, top entry in the lower half */
+static _Atomic uint32_t global_untouched = 0;                   /**< Slots below this index have been handed out before */
+
+static void *global_pool_get(void)
+{
+        uint64_t top = atomic_load(&global_top);
+        while ((uint32_t) top != GLOBAL_EMPTY)
+        {
+                uint32_t entry = (uint32_t) top;
+                uint64_t next = ((top >> 32) + 1) << 32 | atomic_load(&global_next[entry - 1]);
+                if (atomic_compare_exchange_weak(&global_top, &top, next))
+                        return global_slots[entry - 1];
+        }
+
+        uint32_t untouched = atomic_load(&global_untouched);
+        while (untouched < MICROTCP_GLOBAL_POOL_SLOTS)
+        {
+                if (atomic_compare_exchange_weak(&global_untouched, &untouched, untouched + 1))
+                        return global_slots[untouched];
+        }
+        return NULL;
+}
+
+static void global_pool_put(void *buffer)
+{
+        uint32_t entry = ((uint8_t *) buffer - &global_slots[0][0]) / MICROTCP_POOL_SLOT_LEN + 1;
+        uint64_t top = atomic_load(&global_top);
+        do
+        {
+                atomic_store(&global_next[entry - 1], (uint32_t) top);
+        } while (!atomic_compare_exchange_weak(&global_top, &top, ((top >> 32) + 1) << 32 | entry));
+}
+
+int microtcp_pool_init(microtcp_pool_t *pool)
+{
+        pool->slots = aligned_alloc(MICROTCP_CACHE_LINE, MICROTCP_POOL_SLOTS * MICROTCP_POOL_SLOT_LEN);
+        pool->free_mask = (pool->slots != NULL) ? POOL_ALL_FREE : 0;
+        return (pool->slots != NULL) ? 0 : -1;
+}
+
+void microtcp_pool_free(microtcp_pool_t *pool)
+{
+        free(pool->slots);
+        pool->slots = NULL;
+        pool->free_mask = 0;
+}
+
+void *microtcp_pool_get(microtcp_pool_t *pool)
+{
+        if (pool->free_mask == 0)
+                return global_pool_get();
+
+        unsigned slot = __builtin_ctzll(pool->free_mask);
+        pool->free_mask &= pool->free_mask - 1;
+        return pool->slots + slot * MICROTCP_POOL_SLOT_LEN;
+}
+
+void microtcp_pool_put(microtcp_pool_t *pool, void *buffer)
+{
+        uint8_t *slot = buffer;
+        if (slot == NULL)
+                return;
+        if (pool->slots != NULL && slot >= pool->slots && slot < pool->slots + MICROTCP_POOL_SLOTS * MICROTCP_POOL_SLOT_LEN)
+                pool->free_mask |= (uint64_t) 1 << ((slot - pool->slots) / MICROTCP_POOL_SLOT_LEN);
+        else
+                global_pool_put(buffer);
+}
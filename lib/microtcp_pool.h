@@ -0,0 +1,66 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+#ifndef LIB_MICROTCP_POOL_H_
+#define LIB_MICROTCP_POOL_H_
+
+#include "microtcp.h"
+
+#define MICROTCP_CACHE_LINE 64
+/* Size of a pool buffer: a header and a full payload, rounded up to whole cache lines. */
+#define MICROTCP_POOL_SLOT_LEN ((sizeof(microtcp_header_t) + MICROTCP_MSS + MICROTCP_CACHE_LINE - 1) & ~(size_t) (MICROTCP_CACHE_LINE - 1))
+
+/**
+ * @brief Allocates the buffers of a connection's pool, all of them free
+ * @param pool pool to initialize
+ * @returns 0 on success, -1 if the allocation failed
+ */
+int microtcp_pool_init(microtcp_pool_t *pool);
+
+/**
+ * @brief Releases the buffers of a connection's pool, none of them may be in use
+ * @param pool pool to release
+ */
+void microtcp_pool_free(microtcp_pool_t *pool);
+
+/**
+ * @brief Hands out a buffer of MICROTCP_POOL_SLOT_LEN bytes, aligned to a cache line. It comes from the
+ *        connection's pool if one is free, from the pool shared by all connections otherwise.
+ * @param pool pool of the connection, may be uninitialized
+ * @returns the buffer, NULL if both pools are exhausted
+ */
+void *microtcp_pool_get(microtcp_pool_t *pool);
+
+/**
+ * @brief Returns a buffer to the pool it was taken from
+ * @param pool pool the buffer was requested from
+ * @param buffer buffer returned by microtcp_pool_get(), NULL is ignored
+ */
+void microtcp_pool_put(microtcp_pool_t *pool, void *buffer);
+
+#endif /* LIB_MICROTCP_POOL_H_ */
@@ -0,0 +1,144 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+#include "microtcp_ring.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The producer publishes bytes with a release store of head after copying
+ * them, and the consumer acquires head before reading them; tail works the
+ * same way in the other direction. A side only loads the other's index when
+ * its copy does not allow the whole contiguous run up to the end of the
+ * storage, which is rare while the ring is neither full nor empty.
+ */
+
+int microtcp_ring_init(microtcp_ring_t *ring, size_t capacity)
+{
+        ring->data = malloc(capacity);
+        ring->capacity = (ring->data != NULL) ? capacity : 0;
+        atomic_init(&ring->head, 0);
+        atomic_init(&ring->tail, 0);
+        ring->tail_cache = 0;
+        ring->head_cache = 0;
+        return (ring->data != NULL) ? 0 : -1;
+}
+
+void microtcp_ring_free(microtcp_ring_t *ring)
+{
+        free(ring->data);
+        ring->data = NULL;
+        ring->capacity = 0;
+}
+
+size_t microtcp_ring_reserve(microtcp_ring_t *ring, uint8_t **space)
+{
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        size_t offset = head & (ring->capacity - 1);
+        size_t run = ring->capacity - offset;
+
+        if (ring->capacity - (head - ring->tail_cache) < run)
+                ring->tail_cache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        size_t free_len = ring->capacity - (head - ring->tail_cache);
+
+        *space = ring->data + offset;
+        return (free_len < run) ? free_len : run;
+}
+
+void microtcp_ring_commit(microtcp_ring_t *ring, size_t len)
+{
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        atomic_store_explicit(&ring->head, head + len, memory_order_release);
+}
+
+size_t microtcp_ring_peek(microtcp_ring_t *ring, const uint8_t **data)
+{
+        uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        size_t offset = tail & (ring->capacity - 1);
+        size_t run = ring->capacity - offset;
+
+        if (ring->head_cache - tail < run)
+                ring->head_cache = atomic_load_explicit(&ring->head, memory_order_acquire);
+        size_t used = ring->head_cache - tail;
+
+        *data = ring->data + offset;
+        return (used < run) ? used : run;
+}
+
+void microtcp_ring_consume(microtcp_ring_t *ring, size_t len)
+{
+        uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        atomic_store_explicit(&ring->tail, tail + len, memory_order_release);
+}
+
+size_t microtcp_ring_write(microtcp_ring_t *ring, const void *buffer, size_t len)
+{
+        const uint8_t *bytes = buffer;
+        size_t written = 0;
+        uint8_t *space;
+        size_t run;
+
+        /* At most two runs, the second one after wrapping around. */
+        while (written < len && (run = microtcp_ring_reserve(ring, &space)) > 0)
+        {
+                if (run > len - written)
+                        run = len - written;
+                memcpy(space, bytes + written, run);
+                microtcp_ring_commit(ring, run);
+                written += run;
+        }
+
+        return written;
+}
+
+size_t microtcp_ring_read(microtcp_ring_t *ring, void *buffer, size_t len)
+{
+        uint8_t *bytes = buffer;
+        size_t read = 0;
+        const uint8_t *data;
+        size_t run;
+
+        while (read < len && (run = microtcp_ring_peek(ring, &data)) > 0)
+        {
+                if (run > len - read)
+                        run = len - read;
+                memcpy(bytes + read, data, run);
+                microtcp_ring_consume(ring, run);
+                read += run;
+        }
+
+        return read;
+}
+
+size_t microtcp_ring_used(microtcp_ring_t *ring)
+{
+        uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        return head - tail;
+}
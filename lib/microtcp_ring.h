@@ -0,0 +1,125 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+#ifndef LIB_MICROTCP_RING_H_
+#define LIB_MICROTCP_RING_H_
+
+#include "microtcp_pool.h"
+
+#include <stdatomic.h>
+
+/**
+ * Byte ring between exactly one producer thread and one consumer thread.
+ * Each index is only written by its own side, and each side keeps a copy
+ * of the other's index that it refreshes only when the copy says the ring
+ * is full or empty, so neither takes a lock and the two cache lines are
+ * not bounced on every call. Indices count bytes since the ring was
+ * created and are reduced modulo the capacity, a power of two.
+ */
+typedef struct
+{
+        uint8_t *data;   /**< Storage of capacity bytes */
+        size_t capacity; /**< Bytes, a power of two */
+
+        _Atomic uint64_t head __attribute__((aligned(MICROTCP_CACHE_LINE))); /**< Bytes written, only changed by the producer */
+        uint64_t tail_cache;                                                  /**< Producer's copy of tail */
+
+        _Atomic uint64_t tail __attribute__((aligned(MICROTCP_CACHE_LINE))); /**< Bytes read, only changed by the consumer */
+        uint64_t head_cache;                                                  /**< Consumer's copy of head */
+} microtcp_ring_t;
+
+/**
+ * @brief Allocates an empty ring
+ * @param ring ring to initialize
+ * @param capacity bytes the ring holds, a power of two
+ * @returns 0 on success, -1 if the allocation failed
+ */
+int microtcp_ring_init(microtcp_ring_t *ring, size_t capacity);
+
+/**
+ * @brief Releases the storage of a ring, neither side may use it any more
+ * @param ring ring to release
+ */
+void microtcp_ring_free(microtcp_ring_t *ring);
+
+/**
+ * @brief Producer side: finds the free space that follows the written bytes, up to the end of the storage
+ * @param ring ring to write to
+ * @param space set to the start of the free space
+ * @returns bytes that may be written at space, 0 if the ring is full
+ */
+size_t microtcp_ring_reserve(microtcp_ring_t *ring, uint8_t **space);
+
+/**
+ * @brief Producer side: hands bytes written into reserved space to the consumer
+ * @param ring ring written to
+ * @param len bytes written, at most what microtcp_ring_reserve() returned
+ */
+void microtcp_ring_commit(microtcp_ring_t *ring, size_t len);
+
+/**
+ * @brief Consumer side: finds the bytes that have been written and not read yet, up to the end of the storage
+ * @param ring ring to read from
+ * @param data set to the first unread byte
+ * @returns bytes that may be read at data, 0 if the ring is empty
+ */
+size_t microtcp_ring_peek(microtcp_ring_t *ring, const uint8_t **data);
+
+/**
+ * @brief Consumer side: gives the space of bytes that have been read back to the producer
+ * @param ring ring read from
+ * @param len bytes read, at most what microtcp_ring_peek() returned
+ */
+void microtcp_ring_consume(microtcp_ring_t *ring, size_t len);
+
+/**
+ * @brief Producer side: copies as much of a buffer as fits into the ring
+ * @param ring ring to write to
+ * @param buffer bytes to write
+ * @param len length of buffer
+ * @returns bytes written, 0 if the ring is full
+ */
+size_t microtcp_ring_write(microtcp_ring_t *ring, const void *buffer, size_t len);
+
+/**
+ * @brief Consumer side: copies as many bytes as are available into a buffer
+ * @param ring ring to read from
+ * @param buffer where the bytes are copied
+ * @param len length of buffer
+ * @returns bytes read, 0 if the ring is empty
+ */
+size_t microtcp_ring_read(microtcp_ring_t *ring, void *buffer, size_t len);
+
+/**
+ * @brief Bytes written and not read yet, exact for either side's own view, a lower or upper bound for any other thread
+ * @param ring ring to look at
+ * @returns bytes in the ring
+ */
+size_t microtcp_ring_used(microtcp_ring_t *ring);
+
+#endif /* LIB_MICROTCP_RING_H_ */
@@ -0,0 +1,205 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+/*
+ * Checks that the data path does not touch the heap. malloc(), calloc(),
+ * realloc() and aligned_alloc() are interposed and counted while a client
+ * sends TRANSFER_LEN bytes over loopback to a server in a child process,
+ * both with the default socket settings. Every buffer must have been
+ * allocated by the handshake, the count between the handshake and the
+ * shutdown must be zero on both sides.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <arpa/inet.h>
+
+#include "../lib/microtcp.h"
+
+#define TRANSFER_LEN (16 * 1024 * 1024)
+#define CHUNK_LEN (64 * 1024)
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+
+static volatile bool counting;
+static volatile size_t allocations;
+
+void *malloc(size_t size)
+{
+        if (counting)
+                allocations++;
+        return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+        if (counting)
+                allocations++;
+        return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+        if (counting)
+                allocations++;
+        return __libc_realloc(ptr, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+        if (counting)
+                allocations++;
+        return __libc_memalign(alignment, size);
+}
+
+static inline uint8_t pattern(size_t offset)
+{
+        return (uint8_t) (offset * 7 + offset / 251);
+}
+
+static int server(microtcp_sock_t *socket)
+{
+        struct sockaddr_in client;
+        if (microtcp_accept(socket, (struct sockaddr *) &client, sizeof(client)) < 0)
+        {
+                fprintf(stderr, "Error: server accept failed.\n");
+                return EXIT_FAILURE;
+        }
+
+        static uint8_t buffer[CHUNK_LEN];
+        size_t received = 0;
+        counting = true;
+        while (received < TRANSFER_LEN)
+        {
+                ssize_t len = microtcp_recv(socket, buffer, sizeof(buffer), NO_FLAGS_BITS);
+                if (len <= 0)
+                        break;
+                for (ssize_t i = 0; i < len; i++)
+                {
+                        if (buffer[i] != pattern(received + i))
+                        {
+                                counting = false;
+                                fprintf(stderr, "Error: server received a wrong byte at offset %zu.\n", received + i);
+                                return EXIT_FAILURE;
+                        }
+                }
+                received += len;
+        }
+        counting = false;
+
+        /* The FIN is read by one more call, which also closes the connection. */
+        microtcp_recv(socket, buffer, sizeof(buffer), NO_FLAGS_BITS);
+
+        printf("server: %zu bytes received, %zu allocations, recvbuf %zu bytes\n", received, allocations, socket->recvbuf_len);
+        return (received == TRANSFER_LEN && allocations == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int client(const struct sockaddr_in *address, const uint8_t *data)
+{
+        microtcp_sock_t socket = microtcp_socket(AF_INET, SOCK_DGRAM, 0);
+        if (microtcp_connect(&socket, (const struct sockaddr *) address, sizeof(*address)) < 0)
+        {
+                fprintf(stderr, "Error: client connect failed.\n");
+                return EXIT_FAILURE;
+        }
+
+        size_t sent = 0;
+        counting = true;
+        while (sent < TRANSFER_LEN)
+        {
+                ssize_t len = microtcp_send(&socket, data + sent, CHUNK_LEN, NO_FLAGS_BITS);
+                if (len <= 0)
+                        break;
+                sent += len;
+        }
+        counting = false;
+
+        printf("client: %zu bytes sent, %zu allocations\n", sent, allocations);
+        if (microtcp_shutdown(&socket, SHUT_RDWR) < 0)
+        {
+                fprintf(stderr, "Error: client shutdown failed.\n");
+                return EXIT_FAILURE;
+        }
+        return (sent == TRANSFER_LEN && allocations == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(void)
+{
+        uint8_t *data = malloc(TRANSFER_LEN);
+        if (data == NULL)
+        {
+                perror("malloc");
+                return EXIT_FAILURE;
+        }
+        for (size_t i = 0; i < TRANSFER_LEN; i++)
+                data[i] = pattern(i);
+
+        /* The server is bound to a port of the kernel's choice before the client is forked off to connect to it. */
+        struct sockaddr_in address = {.sin_family = AF_INET};
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t address_len = sizeof(address);
+        microtcp_sock_t server_socket = microtcp_socket(AF_INET, SOCK_DGRAM, 0);
+        if (microtcp_bind(&server_socket, (const struct sockaddr *) &address, sizeof(address)) < 0 ||
+            getsockname(server_socket.sd, (struct sockaddr *) &address, &address_len) < 0)
+        {
+                fprintf(stderr, "Error: server bind failed.\n");
+                return EXIT_FAILURE;
+        }
+
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+                perror("fork");
+                return EXIT_FAILURE;
+        }
+        if (pid == 0)
+        {
+                close(server_socket.sd);
+                exit(client(&address, data));
+        }
+
+        int server_status = server(&server_socket);
+        int client_status;
+        if (waitpid(pid, &client_status, 0) < 0)
+        {
+                perror("waitpid");
+                return EXIT_FAILURE;
+        }
+        free(data);
+
+        return (server_status == EXIT_SUCCESS && WIFEXITED(client_status) && WEXITSTATUS(client_status) == EXIT_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,177 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+/*
+ * Compares the CRC-32 implementations of utils/crc32.h on buffers of
+ * segment size and larger, after checking that they agree on every
+ * alignment and on lengths that reach each tail path. "dispatched" is the
+ * one crc32() uses, with carry-less multiplication if the CPU has it.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_RDTSC
+#endif
+
+#include "../lib/microtcp.h"
+#include "../utils/crc32.h"
+
+#define ROUNDS_BYTES (256 * 1024 * 1024)
+#define CHECK_OFFSETS 17
+#define CHECK_LENGTHS 3000
+
+typedef uint32_t (*crc32_update_t)(uint32_t crc, const uint8_t *data, size_t len);
+
+static const struct
+{
+        const char *name;
+        crc32_update_t update;
+} implementations[] = {
+        {"byte-wise", update_crc32},
+        {"slicing-by-8", update_crc32_slice8},
+        {"slicing-by-16", update_crc32_slice16},
+        {"dispatched", update_crc32_fast},
+};
+
+static inline uint64_t
+cycles(void)
+{
+#ifdef HAVE_RDTSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+}
+
+/*
+ * Checks every implementation, and update_crc32_copy() with an unaligned
+ * destination, against the byte-wise CRC-32 of the buffer starting at
+ * offsets 0 to CHECK_OFFSETS - 1, for all lengths below CHECK_LENGTHS.
+ */
+static int check_equivalence(const uint8_t *buffer)
+{
+        static uint8_t copy[CHECK_OFFSETS + CHECK_LENGTHS];
+
+        for (size_t offset = 0; offset < CHECK_OFFSETS; offset++)
+        {
+                for (size_t len = 0; len < CHECK_LENGTHS; len++)
+                {
+                        const uint8_t *data = buffer + offset;
+                        uint32_t expected = update_crc32(0xffffffff, data, len);
+                        for (size_t i = 0; i < sizeof(implementations) / sizeof(implementations[0]); i++)
+                        {
+                                uint32_t crc = implementations[i].update(0xffffffff, data, len);
+                                if (crc != expected)
+                                {
+                                        fprintf(stderr, "Error: %s CRC-32 0x%08x differs from 0x%08x at offset %zu, length %zu.\n",
+                                                implementations[i].name, crc, expected, offset, len);
+                                        return -1;
+                                }
+                        }
+
+                        uint8_t *dst = copy + (CHECK_OFFSETS - 1 - offset);
+                        uint32_t crc = update_crc32_copy(0xffffffff, dst, data, len);
+                        if (crc != expected || memcmp(dst, data, len) != 0)
+                        {
+                                fprintf(stderr, "Error: copying CRC-32 0x%08x differs from 0x%08x or copied wrong bytes at offset %zu, length %zu.\n",
+                                        crc, expected, offset, len);
+                                return -1;
+                        }
+                }
+        }
+
+        return 0;
+}
+
+int main(void)
+{
+        const size_t lengths[] = {MICROTCP_MSS, 64 * 1024};
+        uint8_t *buffer = malloc(lengths[1]);
+        if (buffer == NULL)
+        {
+                perror("malloc");
+                return EXIT_FAILURE;
+        }
+
+#ifdef CRC32_HAVE_CLMUL
+        printf("Carry-less multiplication: %s\n", crc32_clmul_supported() ? "yes" : "no");
+#endif
+
+        srand(335);
+        for (size_t i = 0; i < lengths[1]; i++)
+                buffer[i] = rand();
+
+        if (check_equivalence(buffer) < 0)
+        {
+                free(buffer);
+                return EXIT_FAILURE;
+        }
+        printf("All implementations agree on offsets 0 to %d and lengths 0 to %d.\n", CHECK_OFFSETS - 1, CHECK_LENGTHS - 1);
+
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++)
+        {
+                size_t len = lengths[l];
+                size_t rounds = ROUNDS_BYTES / len;
+                uint32_t expected = update_crc32(0xffffffff, buffer, len);
+
+                printf("%zu byte buffers:\n", len);
+                for (size_t i = 0; i < sizeof(implementations) / sizeof(implementations[0]); i++)
+                {
+                        uint32_t crc = implementations[i].update(0xffffffff, buffer, len);
+                        if (crc != expected)
+                        {
+                                fprintf(stderr, "Error: %s CRC-32 0x%08x differs from 0x%08x.\n", implementations[i].name, crc, expected);
+                                return EXIT_FAILURE;
+                        }
+
+                        struct timespec start, end;
+                        uint64_t start_cycles = cycles();
+                        clock_gettime(CLOCK_MONOTONIC, &start);
+                        for (size_t r = 0; r < rounds; r++)
+                                crc ^= implementations[i].update(crc, buffer, len);
+                        clock_gettime(CLOCK_MONOTONIC, &end);
+                        uint64_t elapsed_cycles = cycles() - start_cycles;
+
+                        double elapsed = end.tv_sec - start.tv_sec + (end.tv_nsec - start.tv_nsec) * 1e-9;
+                        double bytes = (double) rounds * len;
+                        printf("  %-14s %8.1f MB/s", implementations[i].name, bytes / elapsed / (1024.0 * 1024.0));
+                        if (elapsed_cycles > 0)
+                                printf("  %6.3f bytes/cycle", bytes / elapsed_cycles);
+                        printf("  (0x%08x)\n", crc);
+                }
+        }
+
+        free(buffer);
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,279 @@
+/*
+ * microtcp, a lightweight implementation of TCP for teaching,
+ * and academic purposes.
+ *
+ * Copyright (C) 2015-2017  Manolis Surligas <surligas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CS335 - Project Phase B
+ *
+ * Ioannis Spyropoulos - csd5072
+ * Georgios Evangelinos - csd4624
+ * Niki Psoma - csd5038
+ */
+
+/*
+ * Compares the open addressing flow table of lib/microtcp_flow.h, that a
+ * listener looks every received datagram up in, with a chained hash table
+ * at growing numbers of connections. Peers are random, lookups are made in
+ * a random order and half of them are for peers that have no connection.
+ * The addresses looked up are read in sequence, as they would be from the
+ * received datagrams, so that the cost measured is that of the tables.
+ * Both tables must return the same connections, also after removals.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_RDTSC
+#endif
+
+#include "../lib/microtcp.h"
+#include "../lib/microtcp_flow.h"
+
+#define QUERIES (1024 * 1024)
+#define ROUNDS 16
+
+/* A chained hash table, a bucket per entry and an allocation per entry. */
+struct chained_entry
+{
+        uint64_t key;
+        microtcp_sock_t *socket;
+        struct chained_entry *next;
+};
+
+struct chained_table
+{
+        struct chained_entry **buckets;
+        size_t bucket_count;
+};
+
+static inline uint64_t
+chained_key(const struct sockaddr_in *peer)
+{
+        return (uint64_t) peer->sin_addr.s_addr << 16 | peer->sin_port;
+}
+
+static inline size_t
+chained_bucket(const struct chained_table *table, uint64_t key)
+{
+        return (key * 0x9e3779b97f4a7c15ULL) >> 32 & (table->bucket_count - 1);
+}
+
+static int
+chained_init(struct chained_table *table, size_t capacity)
+{
+        table->bucket_count = 16;
+        while (table->bucket_count < capacity)
+                table->bucket_count <<= 1;
+        table->buckets = calloc(table->bucket_count, sizeof(struct chained_entry *));
+        return (table->buckets == NULL) ? -1 : 0;
+}
+
+static void
+chained_free(struct chained_table *table)
+{
+        for (size_t i = 0; i < table->bucket_count; i++)
+        {
+                while (table->buckets[i] != NULL)
+                {
+                        struct chained_entry *next = table->buckets[i]->next;
+                        free(table->buckets[i]);
+                        table->buckets[i] = next;
+                }
+        }
+        free(table->buckets);
+}
+
+static microtcp_sock_t *
+chained_lookup(const struct chained_table *table, const struct sockaddr_in *peer)
+{
+        uint64_t key = chained_key(peer);
+        for (struct chained_entry *entry = table->buckets[chained_bucket(table, key)]; entry != NULL; entry = entry->next)
+        {
+                if (entry->key == key)
+                        return entry->socket;
+        }
+        return NULL;
+}
+
+static int
+chained_insert(struct chained_table *table, const struct sockaddr_in *peer, microtcp_sock_t *socket)
+{
+        struct chained_entry *entry = malloc(sizeof(struct chained_entry));
+        if (entry == NULL)
+                return -1;
+        entry->key = chained_key(peer);
+        entry->socket = socket;
+        entry->next = table->buckets[chained_bucket(table, entry->key)];
+        table->buckets[chained_bucket(table, entry->key)] = entry;
+        return 0;
+}
+
+static void
+chained_remove(struct chained_table *table, const struct sockaddr_in *peer)
+{
+        uint64_t key = chained_key(peer);
+        for (struct chained_entry **link = &table->buckets[chained_bucket(table, key)]; *link != NULL; link = &(*link)->next)
+        {
+                if ((*link)->key == key)
+                {
+                        struct chained_entry *entry = *link;
+                        *link = entry->next;
+                        free(entry);
+                        return;
+                }
+        }
+}
+
+static inline uint64_t
+cycles(void)
+{
+#ifdef HAVE_RDTSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+}
+
+static uint64_t
+random_u64(void)
+{
+        return (uint64_t) rand() << 40 ^ (uint64_t) rand() << 20 ^ rand();
+}
+
+static void
+report(const char *name, size_t lookups, size_t found, const struct timespec *start, const struct timespec *end, uint64_t elapsed_cycles)
+{
+        double elapsed = end->tv_sec - start->tv_sec + (end->tv_nsec - start->tv_nsec) * 1e-9;
+        printf("  %-16s %7.2f ns/lookup", name, elapsed * 1e9 / lookups);
+        if (elapsed_cycles > 0)
+                printf("  %7.1f cycles/lookup", (double) elapsed_cycles / lookups);
+        printf("  (%zu found)\n", found);
+}
+
+int main(void)
+{
+        const size_t counts[] = {1000, 100000, 1000000};
+        const size_t max_count = counts[sizeof(counts) / sizeof(counts[0]) - 1];
+
+        /* The first half of the peers get a connection, the other half are looked up as misses. */
+        struct sockaddr_in *peers = malloc(2 * max_count * sizeof(struct sockaddr_in));
+        struct sockaddr_in *queries = malloc(QUERIES * sizeof(struct sockaddr_in));
+        if (peers == NULL || queries == NULL)
+        {
+                perror("malloc");
+                return EXIT_FAILURE;
+        }
+
+        srand(335);
+        for (size_t i = 0; i < 2 * max_count; i++)
+        {
+                uint64_t r = random_u64();
+                peers[i].sin_family = AF_INET;
+                peers[i].sin_addr.s_addr = (uint32_t) r;
+                peers[i].sin_port = (uint16_t) (r >> 32);
+        }
+
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+        {
+                size_t count = counts[c];
+                struct chained_table chained;
+                microtcp_flow_table_t flows;
+                if (chained_init(&chained, count) < 0 || microtcp_flow_init(&flows, 16) < 0)
+                {
+                        perror("malloc");
+                        return EXIT_FAILURE;
+                }
+
+                /* Random peers may collide, an entry is only added for the first of them. */
+                for (size_t i = 0; i < count; i++)
+                {
+                        microtcp_sock_t *socket = (microtcp_sock_t *) (uintptr_t) (i + 1);
+                        if (chained_lookup(&chained, &peers[i]) != NULL)
+                                continue;
+                        if (chained_insert(&chained, &peers[i], socket) < 0 || microtcp_flow_insert(&flows, &peers[i], socket) < 0)
+                        {
+                                perror("malloc");
+                                return EXIT_FAILURE;
+                        }
+                }
+
+                for (size_t i = 0; i < QUERIES; i++)
+                {
+                        size_t peer = (size_t) (random_u64() % count);
+                        queries[i] = peers[(i & 1) ? peer + max_count : peer];
+                }
+                for (size_t i = 0; i < 2 * count; i++)
+                {
+                        size_t peer = (i < count) ? i : i - count + max_count;
+                        if (chained_lookup(&chained, &peers[peer]) != microtcp_flow_lookup(&flows, &peers[peer]))
+                        {
+                                fprintf(stderr, "Error: the tables differ on peer %zu of %zu.\n", peer, count);
+                                return EXIT_FAILURE;
+                        }
+                }
+
+                printf("%zu connections, %zu slots:\n", flows.count, flows.capacity);
+
+                struct timespec start, end;
+                size_t found = 0;
+                uint64_t start_cycles = cycles();
+                clock_gettime(CLOCK_MONOTONIC, &start);
+                for (size_t r = 0; r < ROUNDS; r++)
+                        for (size_t i = 0; i < QUERIES; i++)
+                                found += chained_lookup(&chained, &queries[i]) != NULL;
+                clock_gettime(CLOCK_MONOTONIC, &end);
+                report("chained", ROUNDS * QUERIES, found, &start, &end, cycles() - start_cycles);
+
+                found = 0;
+                start_cycles = cycles();
+                clock_gettime(CLOCK_MONOTONIC, &start);
+                for (size_t r = 0; r < ROUNDS; r++)
+                        for (size_t i = 0; i < QUERIES; i++)
+                                found += microtcp_flow_lookup(&flows, &queries[i]) != NULL;
+                clock_gettime(CLOCK_MONOTONIC, &end);
+                report("open addressing", ROUNDS * QUERIES, found, &start, &end, cycles() - start_cycles);
+
+                /* Removing every other connection leaves deleted slots the rest must still be found past. */
+                for (size_t i = 0; i < count; i += 2)
+                {
+                        chained_remove(&chained, &peers[i]);
+                        microtcp_flow_remove(&flows, &peers[i]);
+                }
+                for (size_t i = 0; i < count; i++)
+                {
+                        if (chained_lookup(&chained, &peers[i]) != microtcp_flow_lookup(&flows, &peers[i]))
+                        {
+                                fprintf(stderr, "Error: the tables differ on peer %zu of %zu after removals.\n", i, count);
+                                return EXIT_FAILURE;
+                        }
+                }
+
+                chained_free(&chained);
+                microtcp_flow_free(&flows);
+        }
+
+        free(queries);
+        free(peers);
+        return EXIT_SUCCESS;
+}
@@ -21,6 +21,20 @@
 #ifndef UTILS_CRC32_H_
 #define UTILS_CRC32_H_
 
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRC32_HAVE_CLMUL
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define CRC32_HAVE_CLMUL
+#endif
+
 /**
  * CRC-32 calculation using lookup tables, supporting progressive CRC calculation
  * polynomial: 0x104C11DB7
@@ -94,6 +108,1260 @@ update_crc32 (uint32_t crc, const uint8_t *data, size_t len)
   return crc;
 }
 
+/**
+ * Lookup tables of slicing-by-N CRC-32. Table 0 is the table of
+ * update_crc32(), table k advances the CRC of a byte by k more zero bytes,
+ * so N bytes can be folded into the CRC with N independent lookups.
+ *
+ * @return the 16 tables of 256 entries
+ */
+static inline const uint32_t (*
+crc32_slice_lut (void))[256]
+{
+  static const uint32_t lut[16][256] =
+    {
+      {
+        0x00000000L, 0x77073096L, 0xEE0E612CL, 0x990951BAL, 0x076DC419L,
+        0x706AF48FL, 0xE963A535L, 0x9E6495A3L, 0x0EDB8832L, 0x79DCB8A4L,
+        0xE0D5E91EL, 0x97D2D988L, 0x09B64C2BL, 0x7EB17CBDL, 0xE7B82D07L,
+        0x90BF1D91L, 0x1DB71064L, 0x6AB020F2L, 0xF3B97148L, 0x84BE41DEL,
+        0x1ADAD47DL, 0x6DDDE4EBL, 0xF4D4B551L, 0x83D385C7L, 0x136C9856L,
+        0x646BA8C0L, 0xFD62F97AL, 0x8A65C9ECL, 0x14015C4FL, 0x63066CD9L,
+        0xFA0F3D63L, 0x8D080DF5L, 0x3B6E20C8L, 0x4C69105EL, 0xD56041E4L,
+        0xA2677172L, 0x3C03E4D1L, 0x4B04D447L, 0xD20D85FDL, 0xA50AB56BL,
+        0x35B5A8FAL, 0x42B2986CL, 0xDBBBC9D6L, 0xACBCF940L, 0x32D86CE3L,
+        0x45DF5C75L, 0xDCD60DCFL, 0xABD13D59L, 0x26D930ACL, 0x51DE003AL,
+        0xC8D75180L, 0xBFD06116L, 0x21B4F4B5L, 0x56B3C423L, 0xCFBA9599L,
+        0xB8BDA50FL, 0x2802B89EL, 0x5F058808L, 0xC60CD9B2L, 0xB10BE924L,
+        0x2F6F7C87L, 0x58684C11L, 0xC1611DABL, 0xB6662D3DL, 0x76DC4190L,
+        0x01DB7106L, 0x98D220BCL, 0xEFD5102AL, 0x71B18589L, 0x06B6B51FL,
+        0x9FBFE4A5L, 0xE8B8D433L, 0x7807C9A2L, 0x0F00F934L, 0x9609A88EL,
+        0xE10E9818L, 0x7F6A0DBBL, 0x086D3D2DL, 0x91646C97L, 0xE6635C01L,
+        0x6B6B51F4L, 0x1C6C6162L, 0x856530D8L, 0xF262004EL, 0x6C0695EDL,
+        0x1B01A57BL, 0x8208F4C1L, 0xF50FC457L, 0x65B0D9C6L, 0x12B7E950L,
+        0x8BBEB8EAL, 0xFCB9887CL, 0x62DD1DDFL, 0x15DA2D49L, 0x8CD37CF3L,
+        0xFBD44C65L, 0x4DB26158L, 0x3AB551CEL, 0xA3BC0074L, 0xD4BB30E2L,
+        0x4ADFA541L, 0x3DD895D7L, 0xA4D1C46DL, 0xD3D6F4FBL, 0x4369E96AL,
+        0x346ED9FCL, 0xAD678846L, 0xDA60B8D0L, 0x44042D73L, 0x33031DE5L,
+        0xAA0A4C5FL, 0xDD0D7CC9L, 0x5005713CL, 0x270241AAL, 0xBE0B1010L,
+        0xC90C2086L, 0x5768B525L, 0x206F85B3L, 0xB966D409L, 0xCE61E49FL,
+        0x5EDEF90EL, 0x29D9C998L, 0xB0D09822L, 0xC7D7A8B4L, 0x59B33D17L,
+        0x2EB40D81L, 0xB7BD5C3BL, 0xC0BA6CADL, 0xEDB88320L, 0x9ABFB3B6L,
+        0x03B6E20CL, 0x74B1D29AL, 0xEAD54739L, 0x9DD277AFL, 0x04DB2615L,
+        0x73DC1683L, 0xE3630B12L, 0x94643B84L, 0x0D6D6A3EL, 0x7A6A5AA8L,
+        0xE40ECF0BL, 0x9309FF9DL, 0x0A00AE27L, 0x7D079EB1L, 0xF00F9344L,
+        0x8708A3D2L, 0x1E01F268L, 0x6906C2FEL, 0xF762575DL, 0x806567CBL,
+        0x196C3671L, 0x6E6B06E7L, 0xFED41B76L, 0x89D32BE0L, 0x10DA7A5AL,
+        0x67DD4ACCL, 0xF9B9DF6FL, 0x8EBEEFF9L, 0x17B7BE43L, 0x60B08ED5L,
+        0xD6D6A3E8L, 0xA1D1937EL, 0x38D8C2C4L, 0x4FDFF252L, 0xD1BB67F1L,
+        0xA6BC5767L, 0x3FB506DDL, 0x48B2364BL, 0xD80D2BDAL, 0xAF0A1B4CL,
+        0x36034AF6L, 0x41047A60L, 0xDF60EFC3L, 0xA867DF55L, 0x316E8EEFL,
+        0x4669BE79L, 0xCB61B38CL, 0xBC66831AL, 0x256FD2A0L, 0x5268E236L,
+        0xCC0C7795L, 0xBB0B4703L, 0x220216B9L, 0x5505262FL, 0xC5BA3BBEL,
+        0xB2BD0B28L, 0x2BB45A92L, 0x5CB36A04L, 0xC2D7FFA7L, 0xB5D0CF31L,
+        0x2CD99E8BL, 0x5BDEAE1DL, 0x9B64C2B0L, 0xEC63F226L, 0x756AA39CL,
+        0x026D930AL, 0x9C0906A9L, 0xEB0E363FL, 0x72076785L, 0x05005713L,
+        0x95BF4A82L, 0xE2B87A14L, 0x7BB12BAEL, 0x0CB61B38L, 0x92D28E9BL,
+        0xE5D5BE0DL, 0x7CDCEFB7L, 0x0BDBDF21L, 0x86D3D2D4L, 0xF1D4E242L,
+        0x68DDB3F8L, 0x1FDA836EL, 0x81BE16CDL, 0xF6B9265BL, 0x6FB077E1L,
+        0x18B74777L, 0x88085AE6L, 0xFF0F6A70L, 0x66063BCAL, 0x11010B5CL,
+        0x8F659EFFL, 0xF862AE69L, 0x616BFFD3L, 0x166CCF45L, 0xA00AE278L,
+        0xD70DD2EEL, 0x4E048354L, 0x3903B3C2L, 0xA7672661L, 0xD06016F7L,
+        0x4969474DL, 0x3E6E77DBL, 0xAED16A4AL, 0xD9D65ADCL, 0x40DF0B66L,
+        0x37D83BF0L, 0xA9BCAE53L, 0xDEBB9EC5L, 0x47B2CF7FL, 0x30B5FFE9L,
+        0xBDBDF21CL, 0xCABAC28AL, 0x53B39330L, 0x24B4A3A6L, 0xBAD03605L,
+        0xCDD70693L, 0x54DE5729L, 0x23D967BFL, 0xB3667A2EL, 0xC4614AB8L,
+        0x5D681B02L, 0x2A6F2B94L, 0xB40BBE37L, 0xC30C8EA1L, 0x5A05DF1BL,
+        0x2D02EF8DL
+      },
+      {
+        0x00000000L, 0x191B3141L, 0x32366282L, 0x2B2D53C3L, 0x646CC504L,
+        0x7D77F445L, 0x565AA786L, 0x4F4196C7L, 0xC8D98A08L, 0xD1C2BB49L,
+        0xFAEFE88AL, 0xE3F4D9CBL, 0xACB54F0CL, 0xB5AE7E4DL, 0x9E832D8EL,
+        0x87981CCFL, 0x4AC21251L, 0x53D92310L, 0x78F470D3L, 0x61EF4192L,
+        0x2EAED755L, 0x37B5E614L, 0x1C98B5D7L, 0x05838496L, 0x821B9859L,
+        0x9B00A918L, 0xB02DFADBL, 0xA936CB9AL, 0xE6775D5DL, 0xFF6C6C1CL,
+        0xD4413FDFL, 0xCD5A0E9EL, 0x958424A2L, 0x8C9F15E3L, 0xA7B24620L,
+        0xBEA97761L, 0xF1E8E1A6L, 0xE8F3D0E7L, 0xC3DE8324L, 0xDAC5B265L,
+        0x5D5DAEAAL, 0x44469FEBL, 0x6F6BCC28L, 0x7670FD69L, 0x39316BAEL,
+        0x202A5AEFL, 0x0B07092CL, 0x121C386DL, 0xDF4636F3L, 0xC65D07B2L,
+        0xED705471L, 0xF46B6530L, 0xBB2AF3F7L, 0xA231C2B6L, 0x891C9175L,
+        0x9007A034L, 0x179FBCFBL, 0x0E848DBAL, 0x25A9DE79L, 0x3CB2EF38L,
+        0x73F379FFL, 0x6AE848BEL, 0x41C51B7DL, 0x58DE2A3CL, 0xF0794F05L,
+        0xE9627E44L, 0xC24F2D87L, 0xDB541CC6L, 0x94158A01L, 0x8D0EBB40L,
+        0xA623E883L, 0xBF38D9C2L, 0x38A0C50DL, 0x21BBF44CL, 0x0A96A78FL,
+        0x138D96CEL, 0x5CCC0009L, 0x45D73148L, 0x6EFA628BL, 0x77E153CAL,
+        0xBABB5D54L, 0xA3A06C15L, 0x888D3FD6L, 0x91960E97L, 0xDED79850L,
+        0xC7CCA911L, 0xECE1FAD2L, 0xF5FACB93L, 0x7262D75CL, 0x6B79E61DL,
+        0x4054B5DEL, 0x594F849FL, 0x160E1258L, 0x0F152319L, 0x243870DAL,
+        0x3D23419BL, 0x65FD6BA7L, 0x7CE65AE6L, 0x57CB0925L, 0x4ED03864L,
+        0x0191AEA3L, 0x188A9FE2L, 0x33A7CC21L, 0x2ABCFD60L, 0xAD24E1AFL,
+        0xB43FD0EEL, 0x9F12832DL, 0x8609B26CL, 0xC94824ABL, 0xD05315EAL,
+        0xFB7E4629L, 0xE2657768L, 0x2F3F79F6L, 0x362448B7L, 0x1D091B74L,
+        0x04122A35L, 0x4B53BCF2L, 0x52488DB3L, 0x7965DE70L, 0x607EEF31L,
+        0xE7E6F3FEL, 0xFEFDC2BFL, 0xD5D0917CL, 0xCCCBA03DL, 0x838A36FAL,
+        0x9A9107BBL, 0xB1BC5478L, 0xA8A76539L, 0x3B83984BL, 0x2298A90AL,
+        0x09B5FAC9L, 0x10AECB88L, 0x5FEF5D4FL, 0x46F46C0EL, 0x6DD93FCDL,
+        0x74C20E8CL, 0xF35A1243L, 0xEA412302L, 0xC16C70C1L, 0xD8774180L,
+        0x9736D747L, 0x8E2DE606L, 0xA500B5C5L, 0xBC1B8484L, 0x71418A1AL,
+        0x685ABB5BL, 0x4377E898L, 0x5A6CD9D9L, 0x152D4F1EL, 0x0C367E5FL,
+        0x271B2D9CL, 0x3E001CDDL, 0xB9980012L, 0xA0833153L, 0x8BAE6290L,
+        0x92B553D1L, 0xDDF4C516L, 0xC4EFF457L, 0xEFC2A794L, 0xF6D996D5L,
+        0xAE07BCE9L, 0xB71C8DA8L, 0x9C31DE6BL, 0x852AEF2AL, 0xCA6B79EDL,
+        0xD37048ACL, 0xF85D1B6FL, 0xE1462A2EL, 0x66DE36E1L, 0x7FC507A0L,
+        0x54E85463L, 0x4DF36522L, 0x02B2F3E5L, 0x1BA9C2A4L, 0x30849167L,
+        0x299FA026L, 0xE4C5AEB8L, 0xFDDE9FF9L, 0xD6F3CC3AL, 0xCFE8FD7BL,
+        0x80A96BBCL, 0x99B25AFDL, 0xB29F093EL, 0xAB84387FL, 0x2C1C24B0L,
+        0x350715F1L, 0x1E2A4632L, 0x07317773L, 0x4870E1B4L, 0x516BD0F5L,
+        0x7A468336L, 0x635DB277L, 0xCBFAD74EL, 0xD2E1E60FL, 0xF9CCB5CCL,
+        0xE0D7848DL, 0xAF96124AL, 0xB68D230BL, 0x9DA070C8L, 0x84BB4189L,
+        0x03235D46L, 0x1A386C07L, 0x31153FC4L, 0x280E0E85L, 0x674F9842L,
+        0x7E54A903L, 0x5579FAC0L, 0x4C62CB81L, 0x8138C51FL, 0x9823F45EL,
+        0xB30EA79DL, 0xAA1596DCL, 0xE554001BL, 0xFC4F315AL, 0xD7626299L,
+        0xCE7953D8L, 0x49E14F17L, 0x50FA7E56L, 0x7BD72D95L, 0x62CC1CD4L,
+        0x2D8D8A13L, 0x3496BB52L, 0x1FBBE891L, 0x06A0D9D0L, 0x5E7EF3ECL,
+        0x4765C2ADL, 0x6C48916EL, 0x7553A02FL, 0x3A1236E8L, 0x230907A9L,
+        0x0824546AL, 0x113F652BL, 0x96A779E4L, 0x8FBC48A5L, 0xA4911B66L,
+        0xBD8A2A27L, 0xF2CBBCE0L, 0xEBD08DA1L, 0xC0FDDE62L, 0xD9E6EF23L,
+        0x14BCE1BDL, 0x0DA7D0FCL, 0x268A833FL, 0x3F91B27EL, 0x70D024B9L,
+        0x69CB15F8L, 0x42E6463BL, 0x5BFD777AL, 0xDC656BB5L, 0xC57E5AF4L,
+        0xEE530937L, 0xF7483876L, 0xB809AEB1L, 0xA1129FF0L, 0x8A3FCC33L,
+        0x9324FD72L
+      },
+      {
+        0x00000000L, 0x01C26A37L, 0x0384D46EL, 0x0246BE59L, 0x0709A8DCL,
+        0x06CBC2EBL, 0x048D7CB2L, 0x054F1685L, 0x0E1351B8L, 0x0FD13B8FL,
+        0x0D9785D6L, 0x0C55EFE1L, 0x091AF964L, 0x08D89353L, 0x0A9E2D0AL,
+        0x0B5C473DL, 0x1C26A370L, 0x1DE4C947L, 0x1FA2771EL, 0x1E601D29L,
+        0x1B2F0BACL, 0x1AED619BL, 0x18ABDFC2L, 0x1969B5F5L, 0x1235F2C8L,
+        0x13F798FFL, 0x11B126A6L, 0x10734C91L, 0x153C5A14L, 0x14FE3023L,
+        0x16B88E7AL, 0x177AE44DL, 0x384D46E0L, 0x398F2CD7L, 0x3BC9928EL,
+        0x3A0BF8B9L, 0x3F44EE3CL, 0x3E86840BL, 0x3CC03A52L, 0x3D025065L,
+        0x365E1758L, 0x379C7D6FL, 0x35DAC336L, 0x3418A901L, 0x3157BF84L,
+        0x3095D5B3L, 0x32D36BEAL, 0x331101DDL, 0x246BE590L, 0x25A98FA7L,
+        0x27EF31FEL, 0x262D5BC9L, 0x23624D4CL, 0x22A0277BL, 0x20E69922L,
+        0x2124F315L, 0x2A78B428L, 0x2BBADE1FL, 0x29FC6046L, 0x283E0A71L,
+        0x2D711CF4L, 0x2CB376C3L, 0x2EF5C89AL, 0x2F37A2ADL, 0x709A8DC0L,
+        0x7158E7F7L, 0x731E59AEL, 0x72DC3399L, 0x7793251CL, 0x76514F2BL,
+        0x7417F172L, 0x75D59B45L, 0x7E89DC78L, 0x7F4BB64FL, 0x7D0D0816L,
+        0x7CCF6221L, 0x798074A4L, 0x78421E93L, 0x7A04A0CAL, 0x7BC6CAFDL,
+        0x6CBC2EB0L, 0x6D7E4487L, 0x6F38FADEL, 0x6EFA90E9L, 0x6BB5866CL,
+        0x6A77EC5BL, 0x68315202L, 0x69F33835L, 0x62AF7F08L, 0x636D153FL,
+        0x612BAB66L, 0x60E9C151L, 0x65A6D7D4L, 0x6464BDE3L, 0x662203BAL,
+        0x67E0698DL, 0x48D7CB20L, 0x4915A117L, 0x4B531F4EL, 0x4A917579L,
+        0x4FDE63FCL, 0x4E1C09CBL, 0x4C5AB792L, 0x4D98DDA5L, 0x46C49A98L,
+        0x4706F0AFL, 0x45404EF6L, 0x448224C1L, 0x41CD3244L, 0x400F5873L,
+        0x4249E62AL, 0x438B8C1DL, 0x54F16850L, 0x55330267L, 0x5775BC3EL,
+        0x56B7D609L, 0x53F8C08CL, 0x523AAABBL, 0x507C14E2L, 0x51BE7ED5L,
+        0x5AE239E8L, 0x5B2053DFL, 0x5966ED86L, 0x58A487B1L, 0x5DEB9134L,
+        0x5C29FB03L, 0x5E6F455AL, 0x5FAD2F6DL, 0xE1351B80L, 0xE0F771B7L,
+        0xE2B1CFEEL, 0xE373A5D9L, 0xE63CB35CL, 0xE7FED96BL, 0xE5B86732L,
+        0xE47A0D05L, 0xEF264A38L, 0xEEE4200FL, 0xECA29E56L, 0xED60F461L,
+        0xE82FE2E4L, 0xE9ED88D3L, 0xEBAB368AL, 0xEA695CBDL, 0xFD13B8F0L,
+        0xFCD1D2C7L, 0xFE976C9EL, 0xFF5506A9L, 0xFA1A102CL, 0xFBD87A1BL,
+        0xF99EC442L, 0xF85CAE75L, 0xF300E948L, 0xF2C2837FL, 0xF0843D26L,
+        0xF1465711L, 0xF4094194L, 0xF5CB2BA3L, 0xF78D95FAL, 0xF64FFFCDL,
+        0xD9785D60L, 0xD8BA3757L, 0xDAFC890EL, 0xDB3EE339L, 0xDE71F5BCL,
+        0xDFB39F8BL, 0xDDF521D2L, 0xDC374BE5L, 0xD76B0CD8L, 0xD6A966EFL,
+        0xD4EFD8B6L, 0xD52DB281L, 0xD062A404L, 0xD1A0CE33L, 0xD3E6706AL,
+        0xD2241A5DL, 0xC55EFE10L, 0xC49C9427L, 0xC6DA2A7EL, 0xC7184049L,
+        0xC25756CCL, 0xC3953CFBL, 0xC1D382A2L, 0xC011E895L, 0xCB4DAFA8L,
+        0xCA8FC59FL, 0xC8C97BC6L, 0xC90B11F1L, 0xCC440774L, 0xCD866D43L,
+        0xCFC0D31AL, 0xCE02B92DL, 0x91AF9640L, 0x906DFC77L, 0x922B422EL,
+        0x93E92819L, 0x96A63E9CL, 0x976454ABL, 0x9522EAF2L, 0x94E080C5L,
+        0x9FBCC7F8L, 0x9E7EADCFL, 0x9C381396L, 0x9DFA79A1L, 0x98B56F24L,
+        0x99770513L, 0x9B31BB4AL, 0x9AF3D17DL, 0x8D893530L, 0x8C4B5F07L,
+        0x8E0DE15EL, 0x8FCF8B69L, 0x8A809DECL, 0x8B42F7DBL, 0x89044982L,
+        0x88C623B5L, 0x839A6488L, 0x82580EBFL, 0x801EB0E6L, 0x81DCDAD1L,
+        0x8493CC54L, 0x8551A663L, 0x8717183AL, 0x86D5720DL, 0xA9E2D0A0L,
+        0xA820BA97L, 0xAA6604CEL, 0xABA46EF9L, 0xAEEB787CL, 0xAF29124BL,
+        0xAD6FAC12L, 0xACADC625L, 0xA7F18118L, 0xA633EB2FL, 0xA4755576L,
+        0xA5B73F41L, 0xA0F829C4L, 0xA13A43F3L, 0xA37CFDAAL, 0xA2BE979DL,
+        0xB5C473D0L, 0xB40619E7L, 0xB640A7BEL, 0xB782CD89L, 0xB2CDDB0CL,
+        0xB30FB13BL, 0xB1490F62L, 0xB08B6555L, 0xBBD72268L, 0xBA15485FL,
+        0xB853F606L, 0xB9919C31L, 0xBCDE8AB4L, 0xBD1CE083L, 0xBF5A5EDAL,
+        0xBE9834EDL
+      },
+      {
+        0x00000000L, 0xB8BC6765L, 0xAA09C88BL, 0x12B5AFEEL, 0x8F629757L,
+        0x37DEF032L, 0x256B5FDCL, 0x9DD738B9L, 0xC5B428EFL, 0x7D084F8AL,
+        0x6FBDE064L, 0xD7018701L, 0x4AD6BFB8L, 0xF26AD8DDL, 0xE0DF7733L,
+        0x58631056L, 0x5019579FL, 0xE8A530FAL, 0xFA109F14L, 0x42ACF871L,
+        0xDF7BC0C8L, 0x67C7A7ADL, 0x75720843L, 0xCDCE6F26L, 0x95AD7F70L,
+        0x2D111815L, 0x3FA4B7FBL, 0x8718D09EL, 0x1ACFE827L, 0xA2738F42L,
+        0xB0C620ACL, 0x087A47C9L, 0xA032AF3EL, 0x188EC85BL, 0x0A3B67B5L,
+        0xB28700D0L, 0x2F503869L, 0x97EC5F0CL, 0x8559F0E2L, 0x3DE59787L,
+        0x658687D1L, 0xDD3AE0B4L, 0xCF8F4F5AL, 0x7733283FL, 0xEAE41086L,
+        0x525877E3L, 0x40EDD80DL, 0xF851BF68L, 0xF02BF8A1L, 0x48979FC4L,
+        0x5A22302AL, 0xE29E574FL, 0x7F496FF6L, 0xC7F50893L, 0xD540A77DL,
+        0x6DFCC018L, 0x359FD04EL, 0x8D23B72BL, 0x9F9618C5L, 0x272A7FA0L,
+        0xBAFD4719L, 0x0241207CL, 0x10F48F92L, 0xA848E8F7L, 0x9B14583DL,
+        0x23A83F58L, 0x311D90B6L, 0x89A1F7D3L, 0x1476CF6AL, 0xACCAA80FL,
+        0xBE7F07E1L, 0x06C36084L, 0x5EA070D2L, 0xE61C17B7L, 0xF4A9B859L,
+        0x4C15DF3CL, 0xD1C2E785L, 0x697E80E0L, 0x7BCB2F0EL, 0xC377486BL,
+        0xCB0D0FA2L, 0x73B168C7L, 0x6104C729L, 0xD9B8A04CL, 0x446F98F5L,
+        0xFCD3FF90L, 0xEE66507EL, 0x56DA371BL, 0x0EB9274DL, 0xB6054028L,
+        0xA4B0EFC6L, 0x1C0C88A3L, 0x81DBB01AL, 0x3967D77FL, 0x2BD27891L,
+        0x936E1FF4L, 0x3B26F703L, 0x839A9066L, 0x912F3F88L, 0x299358EDL,
+        0xB4446054L, 0x0CF80731L, 0x1E4DA8DFL, 0xA6F1CFBAL, 0xFE92DFECL,
+        0x462EB889L, 0x549B1767L, 0xEC277002L, 0x71F048BBL, 0xC94C2FDEL,
+        0xDBF98030L, 0x6345E755L, 0x6B3FA09CL, 0xD383C7F9L, 0xC1366817L,
+        0x798A0F72L, 0xE45D37CBL, 0x5CE150AEL, 0x4E54FF40L, 0xF6E89825L,
+        0xAE8B8873L, 0x1637EF16L, 0x048240F8L, 0xBC3E279DL, 0x21E91F24L,
+        0x99557841L, 0x8BE0D7AFL, 0x335CB0CAL, 0xED59B63BL, 0x55E5D15EL,
+        0x47507EB0L, 0xFFEC19D5L, 0x623B216CL, 0xDA874609L, 0xC832E9E7L,
+        0x708E8E82L, 0x28ED9ED4L, 0x9051F9B1L, 0x82E4565FL, 0x3A58313AL,
+        0xA78F0983L, 0x1F336EE6L, 0x0D86C108L, 0xB53AA66DL, 0xBD40E1A4L,
+        0x05FC86C1L, 0x1749292FL, 0xAFF54E4AL, 0x322276F3L, 0x8A9E1196L,
+        0x982BBE78L, 0x2097D91DL, 0x78F4C94BL, 0xC048AE2EL, 0xD2FD01C0L,
+        0x6A4166A5L, 0xF7965E1CL, 0x4F2A3979L, 0x5D9F9697L, 0xE523F1F2L,
+        0x4D6B1905L, 0xF5D77E60L, 0xE762D18EL, 0x5FDEB6EBL, 0xC2098E52L,
+        0x7AB5E937L, 0x680046D9L, 0xD0BC21BCL, 0x88DF31EAL, 0x3063568FL,
+        0x22D6F961L, 0x9A6A9E04L, 0x07BDA6BDL, 0xBF01C1D8L, 0xADB46E36L,
+        0x15080953L, 0x1D724E9AL, 0xA5CE29FFL, 0xB77B8611L, 0x0FC7E174L,
+        0x9210D9CDL, 0x2AACBEA8L, 0x38191146L, 0x80A57623L, 0xD8C66675L,
+        0x607A0110L, 0x72CFAEFEL, 0xCA73C99BL, 0x57A4F122L, 0xEF189647L,
+        0xFDAD39A9L, 0x45115ECCL, 0x764DEE06L, 0xCEF18963L, 0xDC44268DL,
+        0x64F841E8L, 0xF92F7951L, 0x41931E34L, 0x5326B1DAL, 0xEB9AD6BFL,
+        0xB3F9C6E9L, 0x0B45A18CL, 0x19F00E62L, 0xA14C6907L, 0x3C9B51BEL,
+        0x842736DBL, 0x96929935L, 0x2E2EFE50L, 0x2654B999L, 0x9EE8DEFCL,
+        0x8C5D7112L, 0x34E11677L, 0xA9362ECEL, 0x118A49ABL, 0x033FE645L,
+        0xBB838120L, 0xE3E09176L, 0x5B5CF613L, 0x49E959FDL, 0xF1553E98L,
+        0x6C820621L, 0xD43E6144L, 0xC68BCEAAL, 0x7E37A9CFL, 0xD67F4138L,
+        0x6EC3265DL, 0x7C7689B3L, 0xC4CAEED6L, 0x591DD66FL, 0xE1A1B10AL,
+        0xF3141EE4L, 0x4BA87981L, 0x13CB69D7L, 0xAB770EB2L, 0xB9C2A15CL,
+        0x017EC639L, 0x9CA9FE80L, 0x241599E5L, 0x36A0360BL, 0x8E1C516EL,
+        0x866616A7L, 0x3EDA71C2L, 0x2C6FDE2CL, 0x94D3B949L, 0x090481F0L,
+        0xB1B8E695L, 0xA30D497BL, 0x1BB12E1EL, 0x43D23E48L, 0xFB6E592DL,
+        0xE9DBF6C3L, 0x516791A6L, 0xCCB0A91FL, 0x740CCE7AL, 0x66B96194L,
+        0xDE0506F1L
+      },
+      {
+        0x00000000L, 0x3D6029B0L, 0x7AC05360L, 0x47A07AD0L, 0xF580A6C0L,
+        0xC8E08F70L, 0x8F40F5A0L, 0xB220DC10L, 0x30704BC1L, 0x0D106271L,
+        0x4AB018A1L, 0x77D03111L, 0xC5F0ED01L, 0xF890C4B1L, 0xBF30BE61L,
+        0x825097D1L, 0x60E09782L, 0x5D80BE32L, 0x1A20C4E2L, 0x2740ED52L,
+        0x95603142L, 0xA80018F2L, 0xEFA06222L, 0xD2C04B92L, 0x5090DC43L,
+        0x6DF0F5F3L, 0x2A508F23L, 0x1730A693L, 0xA5107A83L, 0x98705333L,
+        0xDFD029E3L, 0xE2B00053L, 0xC1C12F04L, 0xFCA106B4L, 0xBB017C64L,
+        0x866155D4L, 0x344189C4L, 0x0921A074L, 0x4E81DAA4L, 0x73E1F314L,
+        0xF1B164C5L, 0xCCD14D75L, 0x8B7137A5L, 0xB6111E15L, 0x0431C205L,
+        0x3951EBB5L, 0x7EF19165L, 0x4391B8D5L, 0xA121B886L, 0x9C419136L,
+        0xDBE1EBE6L, 0xE681C256L, 0x54A11E46L, 0x69C137F6L, 0x2E614D26L,
+        0x13016496L, 0x9151F347L, 0xAC31DAF7L, 0xEB91A027L, 0xD6F18997L,
+        0x64D15587L, 0x59B17C37L, 0x1E1106E7L, 0x23712F57L, 0x58F35849L,
+        0x659371F9L, 0x22330B29L, 0x1F532299L, 0xAD73FE89L, 0x9013D739L,
+        0xD7B3ADE9L, 0xEAD38459L, 0x68831388L, 0x55E33A38L, 0x124340E8L,
+        0x2F236958L, 0x9D03B548L, 0xA0639CF8L, 0xE7C3E628L, 0xDAA3CF98L,
+        0x3813CFCBL, 0x0573E67BL, 0x42D39CABL, 0x7FB3B51BL, 0xCD93690BL,
+        0xF0F340BBL, 0xB7533A6BL, 0x8A3313DBL, 0x0863840AL, 0x3503ADBAL,
+        0x72A3D76AL, 0x4FC3FEDAL, 0xFDE322CAL, 0xC0830B7AL, 0x872371AAL,
+        0xBA43581AL, 0x9932774DL, 0xA4525EFDL, 0xE3F2242DL, 0xDE920D9DL,
+        0x6CB2D18DL, 0x51D2F83DL, 0x167282EDL, 0x2B12AB5DL, 0xA9423C8CL,
+        0x9422153CL, 0xD3826FECL, 0xEEE2465CL, 0x5CC29A4CL, 0x61A2B3FCL,
+        0x2602C92CL, 0x1B62E09CL, 0xF9D2E0CFL, 0xC4B2C97FL, 0x8312B3AFL,
+        0xBE729A1FL, 0x0C52460FL, 0x31326FBFL, 0x7692156FL, 0x4BF23CDFL,
+        0xC9A2AB0EL, 0xF4C282BEL, 0xB362F86EL, 0x8E02D1DEL, 0x3C220DCEL,
+        0x0142247EL, 0x46E25EAEL, 0x7B82771EL, 0xB1E6B092L, 0x8C869922L,
+        0xCB26E3F2L, 0xF646CA42L, 0x44661652L, 0x79063FE2L, 0x3EA64532L,
+        0x03C66C82L, 0x8196FB53L, 0xBCF6D2E3L, 0xFB56A833L, 0xC6368183L,
+        0x74165D93L, 0x49767423L, 0x0ED60EF3L, 0x33B62743L, 0xD1062710L,
+        0xEC660EA0L, 0xABC67470L, 0x96A65DC0L, 0x248681D0L, 0x19E6A860L,
+        0x5E46D2B0L, 0x6326FB00L, 0xE1766CD1L, 0xDC164561L, 0x9BB63FB1L,
+        0xA6D61601L, 0x14F6CA11L, 0x2996E3A1L, 0x6E369971L, 0x5356B0C1L,
+        0x70279F96L, 0x4D47B626L, 0x0AE7CCF6L, 0x3787E546L, 0x85A73956L,
+        0xB8C710E6L, 0xFF676A36L, 0xC2074386L, 0x4057D457L, 0x7D37FDE7L,
+        0x3A978737L, 0x07F7AE87L, 0xB5D77297L, 0x88B75B27L, 0xCF1721F7L,
+        0xF2770847L, 0x10C70814L, 0x2DA721A4L, 0x6A075B74L, 0x576772C4L,
+        0xE547AED4L, 0xD8278764L, 0x9F87FDB4L, 0xA2E7D404L, 0x20B743D5L,
+        0x1DD76A65L, 0x5A7710B5L, 0x67173905L, 0xD537E515L, 0xE857CCA5L,
+        0xAFF7B675L, 0x92979FC5L, 0xE915E8DBL, 0xD475C16BL, 0x93D5BBBBL,
+        0xAEB5920BL, 0x1C954E1BL, 0x21F567ABL, 0x66551D7BL, 0x5B3534CBL,
+        0xD965A31AL, 0xE4058AAAL, 0xA3A5F07AL, 0x9EC5D9CAL, 0x2CE505DAL,
+        0x11852C6AL, 0x562556BAL, 0x6B457F0AL, 0x89F57F59L, 0xB49556E9L,
+        0xF3352C39L, 0xCE550589L, 0x7C75D999L, 0x4115F029L, 0x06B58AF9L,
+        0x3BD5A349L, 0xB9853498L, 0x84E51D28L, 0xC34567F8L, 0xFE254E48L,
+        0x4C059258L, 0x7165BBE8L, 0x36C5C138L, 0x0BA5E888L, 0x28D4C7DFL,
+        0x15B4EE6FL, 0x521494BFL, 0x6F74BD0FL, 0xDD54611FL, 0xE03448AFL,
+        0xA794327FL, 0x9AF41BCFL, 0x18A48C1EL, 0x25C4A5AEL, 0x6264DF7EL,
+        0x5F04F6CEL, 0xED242ADEL, 0xD044036EL, 0x97E479BEL, 0xAA84500EL,
+        0x4834505DL, 0x755479EDL, 0x32F4033DL, 0x0F942A8DL, 0xBDB4F69DL,
+        0x80D4DF2DL, 0xC774A5FDL, 0xFA148C4DL, 0x78441B9CL, 0x4524322CL,
+        0x028448FCL, 0x3FE4614CL, 0x8DC4BD5CL, 0xB0A494ECL, 0xF704EE3CL,
+        0xCA64C78CL
+      },
+      {
+        0x00000000L, 0xCB5CD3A5L, 0x4DC8A10BL, 0x869472AEL, 0x9B914216L,
+        0x50CD91B3L, 0xD659E31DL, 0x1D0530B8L, 0xEC53826DL, 0x270F51C8L,
+        0xA19B2366L, 0x6AC7F0C3L, 0x77C2C07BL, 0xBC9E13DEL, 0x3A0A6170L,
+        0xF156B2D5L, 0x03D6029BL, 0xC88AD13EL, 0x4E1EA390L, 0x85427035L,
+        0x9847408DL, 0x531B9328L, 0xD58FE186L, 0x1ED33223L, 0xEF8580F6L,
+        0x24D95353L, 0xA24D21FDL, 0x6911F258L, 0x7414C2E0L, 0xBF481145L,
+        0x39DC63EBL, 0xF280B04EL, 0x07AC0536L, 0xCCF0D693L, 0x4A64A43DL,
+        0x81387798L, 0x9C3D4720L, 0x57619485L, 0xD1F5E62BL, 0x1AA9358EL,
+        0xEBFF875BL, 0x20A354FEL, 0xA6372650L, 0x6D6BF5F5L, 0x706EC54DL,
+        0xBB3216E8L, 0x3DA66446L, 0xF6FAB7E3L, 0x047A07ADL, 0xCF26D408L,
+        0x49B2A6A6L, 0x82EE7503L, 0x9FEB45BBL, 0x54B7961EL, 0xD223E4B0L,
+        0x197F3715L, 0xE82985C0L, 0x23755665L, 0xA5E124CBL, 0x6EBDF76EL,
+        0x73B8C7D6L, 0xB8E41473L, 0x3E7066DDL, 0xF52CB578L, 0x0F580A6CL,
+        0xC404D9C9L, 0x4290AB67L, 0x89CC78C2L, 0x94C9487AL, 0x5F959BDFL,
+        0xD901E971L, 0x125D3AD4L, 0xE30B8801L, 0x28575BA4L, 0xAEC3290AL,
+        0x659FFAAFL, 0x789ACA17L, 0xB3C619B2L, 0x35526B1CL, 0xFE0EB8B9L,
+        0x0C8E08F7L, 0xC7D2DB52L, 0x4146A9FCL, 0x8A1A7A59L, 0x971F4AE1L,
+        0x5C439944L, 0xDAD7EBEAL, 0x118B384FL, 0xE0DD8A9AL, 0x2B81593FL,
+        0xAD152B91L, 0x6649F834L, 0x7B4CC88CL, 0xB0101B29L, 0x36846987L,
+        0xFDD8BA22L, 0x08F40F5AL, 0xC3A8DCFFL, 0x453CAE51L, 0x8E607DF4L,
+        0x93654D4CL, 0x58399EE9L, 0xDEADEC47L, 0x15F13FE2L, 0xE4A78D37L,
+        0x2FFB5E92L, 0xA96F2C3CL, 0x6233FF99L, 0x7F36CF21L, 0xB46A1C84L,
+        0x32FE6E2AL, 0xF9A2BD8FL, 0x0B220DC1L, 0xC07EDE64L, 0x46EAACCAL,
+        0x8DB67F6FL, 0x90B34FD7L, 0x5BEF9C72L, 0xDD7BEEDCL, 0x16273D79L,
+        0xE7718FACL, 0x2C2D5C09L, 0xAAB92EA7L, 0x61E5FD02L, 0x7CE0CDBAL,
+        0xB7BC1E1FL, 0x31286CB1L, 0xFA74BF14L, 0x1EB014D8L, 0xD5ECC77DL,
+        0x5378B5D3L, 0x98246676L, 0x852156CEL, 0x4E7D856BL, 0xC8E9F7C5L,
+        0x03B52460L, 0xF2E396B5L, 0x39BF4510L, 0xBF2B37BEL, 0x7477E41BL,
+        0x6972D4A3L, 0xA22E0706L, 0x24BA75A8L, 0xEFE6A60DL, 0x1D661643L,
+        0xD63AC5E6L, 0x50AEB748L, 0x9BF264EDL, 0x86F75455L, 0x4DAB87F0L,
+        0xCB3FF55EL, 0x006326FBL, 0xF135942EL, 0x3A69478BL, 0xBCFD3525L,
+        0x77A1E680L, 0x6AA4D638L, 0xA1F8059DL, 0x276C7733L, 0xEC30A496L,
+        0x191C11EEL, 0xD240C24BL, 0x54D4B0E5L, 0x9F886340L, 0x828D53F8L,
+        0x49D1805DL, 0xCF45F2F3L, 0x04192156L, 0xF54F9383L, 0x3E134026L,
+        0xB8873288L, 0x73DBE12DL, 0x6EDED195L, 0xA5820230L, 0x2316709EL,
+        0xE84AA33BL, 0x1ACA1375L, 0xD196C0D0L, 0x5702B27EL, 0x9C5E61DBL,
+        0x815B5163L, 0x4A0782C6L, 0xCC93F068L, 0x07CF23CDL, 0xF6999118L,
+        0x3DC542BDL, 0xBB513013L, 0x700DE3B6L, 0x6D08D30EL, 0xA65400ABL,
+        0x20C07205L, 0xEB9CA1A0L, 0x11E81EB4L, 0xDAB4CD11L, 0x5C20BFBFL,
+        0x977C6C1AL, 0x8A795CA2L, 0x41258F07L, 0xC7B1FDA9L, 0x0CED2E0CL,
+        0xFDBB9CD9L, 0x36E74F7CL, 0xB0733DD2L, 0x7B2FEE77L, 0x662ADECFL,
+        0xAD760D6AL, 0x2BE27FC4L, 0xE0BEAC61L, 0x123E1C2FL, 0xD962CF8AL,
+        0x5FF6BD24L, 0x94AA6E81L, 0x89AF5E39L, 0x42F38D9CL, 0xC467FF32L,
+        0x0F3B2C97L, 0xFE6D9E42L, 0x35314DE7L, 0xB3A53F49L, 0x78F9ECECL,
+        0x65FCDC54L, 0xAEA00FF1L, 0x28347D5FL, 0xE368AEFAL, 0x16441B82L,
+        0xDD18C827L, 0x5B8CBA89L, 0x90D0692CL, 0x8DD55994L, 0x46898A31L,
+        0xC01DF89FL, 0x0B412B3AL, 0xFA1799EFL, 0x314B4A4AL, 0xB7DF38E4L,
+        0x7C83EB41L, 0x6186DBF9L, 0xAADA085CL, 0x2C4E7AF2L, 0xE712A957L,
+        0x15921919L, 0xDECECABCL, 0x585AB812L, 0x93066BB7L, 0x8E035B0FL,
+        0x455F88AAL, 0xC3CBFA04L, 0x089729A1L, 0xF9C19B74L, 0x329D48D1L,
+        0xB4093A7FL, 0x7F55E9DAL, 0x6250D962L, 0xA90C0AC7L, 0x2F987869L,
+        0xE4C4ABCCL
+      },
+      {
+        0x00000000L, 0xA6770BB4L, 0x979F1129L, 0x31E81A9DL, 0xF44F2413L,
+        0x52382FA7L, 0x63D0353AL, 0xC5A73E8EL, 0x33EF4E67L, 0x959845D3L,
+        0xA4705F4EL, 0x020754FAL, 0xC7A06A74L, 0x61D761C0L, 0x503F7B5DL,
+        0xF64870E9L, 0x67DE9CCEL, 0xC1A9977AL, 0xF0418DE7L, 0x56368653L,
+        0x9391B8DDL, 0x35E6B369L, 0x040EA9F4L, 0xA279A240L, 0x5431D2A9L,
+        0xF246D91DL, 0xC3AEC380L, 0x65D9C834L, 0xA07EF6BAL, 0x0609FD0EL,
+        0x37E1E793L, 0x9196EC27L, 0xCFBD399CL, 0x69CA3228L, 0x582228B5L,
+        0xFE552301L, 0x3BF21D8FL, 0x9D85163BL, 0xAC6D0CA6L, 0x0A1A0712L,
+        0xFC5277FBL, 0x5A257C4FL, 0x6BCD66D2L, 0xCDBA6D66L, 0x081D53E8L,
+        0xAE6A585CL, 0x9F8242C1L, 0x39F54975L, 0xA863A552L, 0x0E14AEE6L,
+        0x3FFCB47BL, 0x998BBFCFL, 0x5C2C8141L, 0xFA5B8AF5L, 0xCBB39068L,
+        0x6DC49BDCL, 0x9B8CEB35L, 0x3DFBE081L, 0x0C13FA1CL, 0xAA64F1A8L,
+        0x6FC3CF26L, 0xC9B4C492L, 0xF85CDE0FL, 0x5E2BD5BBL, 0x440B7579L,
+        0xE27C7ECDL, 0xD3946450L, 0x75E36FE4L, 0xB044516AL, 0x16335ADEL,
+        0x27DB4043L, 0x81AC4BF7L, 0x77E43B1EL, 0xD19330AAL, 0xE07B2A37L,
+        0x460C2183L, 0x83AB1F0DL, 0x25DC14B9L, 0x14340E24L, 0xB2430590L,
+        0x23D5E9B7L, 0x85A2E203L, 0xB44AF89EL, 0x123DF32AL, 0xD79ACDA4L,
+        0x71EDC610L, 0x4005DC8DL, 0xE672D739L, 0x103AA7D0L, 0xB64DAC64L,
+        0x87A5B6F9L, 0x21D2BD4DL, 0xE47583C3L, 0x42028877L, 0x73EA92EAL,
+        0xD59D995EL, 0x8BB64CE5L, 0x2DC14751L, 0x1C295DCCL, 0xBA5E5678L,
+        0x7FF968F6L, 0xD98E6342L, 0xE86679DFL, 0x4E11726BL, 0xB8590282L,
+        0x1E2E0936L, 0x2FC613ABL, 0x89B1181FL, 0x4C162691L, 0xEA612D25L,
+        0xDB8937B8L, 0x7DFE3C0CL, 0xEC68D02BL, 0x4A1FDB9FL, 0x7BF7C102L,
+        0xDD80CAB6L, 0x1827F438L, 0xBE50FF8CL, 0x8FB8E511L, 0x29CFEEA5L,
+        0xDF879E4CL, 0x79F095F8L, 0x48188F65L, 0xEE6F84D1L, 0x2BC8BA5FL,
+        0x8DBFB1EBL, 0xBC57AB76L, 0x1A20A0C2L, 0x8816EAF2L, 0x2E61E146L,
+        0x1F89FBDBL, 0xB9FEF06FL, 0x7C59CEE1L, 0xDA2EC555L, 0xEBC6DFC8L,
+        0x4DB1D47CL, 0xBBF9A495L, 0x1D8EAF21L, 0x2C66B5BCL, 0x8A11BE08L,
+        0x4FB68086L, 0xE9C18B32L, 0xD82991AFL, 0x7E5E9A1BL, 0xEFC8763CL,
+        0x49BF7D88L, 0x78576715L, 0xDE206CA1L, 0x1B87522FL, 0xBDF0599BL,
+        0x8C184306L, 0x2A6F48B2L, 0xDC27385BL, 0x7A5033EFL, 0x4BB82972L,
+        0xEDCF22C6L, 0x28681C48L, 0x8E1F17FCL, 0xBFF70D61L, 0x198006D5L,
+        0x47ABD36EL, 0xE1DCD8DAL, 0xD034C247L, 0x7643C9F3L, 0xB3E4F77DL,
+        0x1593FCC9L, 0x247BE654L, 0x820CEDE0L, 0x74449D09L, 0xD23396BDL,
+        0xE3DB8C20L, 0x45AC8794L, 0x800BB91AL, 0x267CB2AEL, 0x1794A833L,
+        0xB1E3A387L, 0x20754FA0L, 0x86024414L, 0xB7EA5E89L, 0x119D553DL,
+        0xD43A6BB3L, 0x724D6007L, 0x43A57A9AL, 0xE5D2712EL, 0x139A01C7L,
+        0xB5ED0A73L, 0x840510EEL, 0x22721B5AL, 0xE7D525D4L, 0x41A22E60L,
+        0x704A34FDL, 0xD63D3F49L, 0xCC1D9F8BL, 0x6A6A943FL, 0x5B828EA2L,
+        0xFDF58516L, 0x3852BB98L, 0x9E25B02CL, 0xAFCDAAB1L, 0x09BAA105L,
+        0xFFF2D1ECL, 0x5985DA58L, 0x686DC0C5L, 0xCE1ACB71L, 0x0BBDF5FFL,
+        0xADCAFE4BL, 0x9C22E4D6L, 0x3A55EF62L, 0xABC30345L, 0x0DB408F1L,
+        0x3C5C126CL, 0x9A2B19D8L, 0x5F8C2756L, 0xF9FB2CE2L, 0xC813367FL,
+        0x6E643DCBL, 0x982C4D22L, 0x3E5B4696L, 0x0FB35C0BL, 0xA9C457BFL,
+        0x6C636931L, 0xCA146285L, 0xFBFC7818L, 0x5D8B73ACL, 0x03A0A617L,
+        0xA5D7ADA3L, 0x943FB73EL, 0x3248BC8AL, 0xF7EF8204L, 0x519889B0L,
+        0x6070932DL, 0xC6079899L, 0x304FE870L, 0x9638E3C4L, 0xA7D0F959L,
+        0x01A7F2EDL, 0xC400CC63L, 0x6277C7D7L, 0x539FDD4AL, 0xF5E8D6FEL,
+        0x647E3AD9L, 0xC209316DL, 0xF3E12BF0L, 0x55962044L, 0x90311ECAL,
+        0x3646157EL, 0x07AE0FE3L, 0xA1D90457L, 0x579174BEL, 0xF1E67F0AL,
+        0xC00E6597L, 0x66796E23L, 0xA3DE50ADL, 0x05A95B19L, 0x34414184L,
+        0x92364A30L
+      },
+      {
+        0x00000000L, 0xCCAA009EL, 0x4225077DL, 0x8E8F07E3L, 0x844A0EFAL,
+        0x48E00E64L, 0xC66F0987L, 0x0AC50919L, 0xD3E51BB5L, 0x1F4F1B2BL,
+        0x91C01CC8L, 0x5D6A1C56L, 0x57AF154FL, 0x9B0515D1L, 0x158A1232L,
+        0xD92012ACL, 0x7CBB312BL, 0xB01131B5L, 0x3E9E3656L, 0xF23436C8L,
+        0xF8F13FD1L, 0x345B3F4FL, 0xBAD438ACL, 0x767E3832L, 0xAF5E2A9EL,
+        0x63F42A00L, 0xED7B2DE3L, 0x21D12D7DL, 0x2B142464L, 0xE7BE24FAL,
+        0x69312319L, 0xA59B2387L, 0xF9766256L, 0x35DC62C8L, 0xBB53652BL,
+        0x77F965B5L, 0x7D3C6CACL, 0xB1966C32L, 0x3F196BD1L, 0xF3B36B4FL,
+        0x2A9379E3L, 0xE639797DL, 0x68B67E9EL, 0xA41C7E00L, 0xAED97719L,
+        0x62737787L, 0xECFC7064L, 0x205670FAL, 0x85CD537DL, 0x496753E3L,
+        0xC7E85400L, 0x0B42549EL, 0x01875D87L, 0xCD2D5D19L, 0x43A25AFAL,
+        0x8F085A64L, 0x562848C8L, 0x9A824856L, 0x140D4FB5L, 0xD8A74F2BL,
+        0xD2624632L, 0x1EC846ACL, 0x9047414FL, 0x5CED41D1L, 0x299DC2EDL,
+        0xE537C273L, 0x6BB8C590L, 0xA712C50EL, 0xADD7CC17L, 0x617DCC89L,
+        0xEFF2CB6AL, 0x2358CBF4L, 0xFA78D958L, 0x36D2D9C6L, 0xB85DDE25L,
+        0x74F7DEBBL, 0x7E32D7A2L, 0xB298D73CL, 0x3C17D0DFL, 0xF0BDD041L,
+        0x5526F3C6L, 0x998CF358L, 0x1703F4BBL, 0xDBA9F425L, 0xD16CFD3CL,
+        0x1DC6FDA2L, 0x9349FA41L, 0x5FE3FADFL, 0x86C3E873L, 0x4A69E8EDL,
+        0xC4E6EF0EL, 0x084CEF90L, 0x0289E689L, 0xCE23E617L, 0x40ACE1F4L,
+        0x8C06E16AL, 0xD0EBA0BBL, 0x1C41A025L, 0x92CEA7C6L, 0x5E64A758L,
+        0x54A1AE41L, 0x980BAEDFL, 0x1684A93CL, 0xDA2EA9A2L, 0x030EBB0EL,
+        0xCFA4BB90L, 0x412BBC73L, 0x8D81BCEDL, 0x8744B5F4L, 0x4BEEB56AL,
+        0xC561B289L, 0x09CBB217L, 0xAC509190L, 0x60FA910EL, 0xEE7596EDL,
+        0x22DF9673L, 0x281A9F6AL, 0xE4B09FF4L, 0x6A3F9817L, 0xA6959889L,
+        0x7FB58A25L, 0xB31F8ABBL, 0x3D908D58L, 0xF13A8DC6L, 0xFBFF84DFL,
+        0x37558441L, 0xB9DA83A2L, 0x7570833CL, 0x533B85DAL, 0x9F918544L,
+        0x111E82A7L, 0xDDB48239L, 0xD7718B20L, 0x1BDB8BBEL, 0x95548C5DL,
+        0x59FE8CC3L, 0x80DE9E6FL, 0x4C749EF1L, 0xC2FB9912L, 0x0E51998CL,
+        0x04949095L, 0xC83E900BL, 0x46B197E8L, 0x8A1B9776L, 0x2F80B4F1L,
+        0xE32AB46FL, 0x6DA5B38CL, 0xA10FB312L, 0xABCABA0BL, 0x6760BA95L,
+        0xE9EFBD76L, 0x2545BDE8L, 0xFC65AF44L, 0x30CFAFDAL, 0xBE40A839L,
+        0x72EAA8A7L, 0x782FA1BEL, 0xB485A120L, 0x3A0AA6C3L, 0xF6A0A65DL,
+        0xAA4DE78CL, 0x66E7E712L, 0xE868E0F1L, 0x24C2E06FL, 0x2E07E976L,
+        0xE2ADE9E8L, 0x6C22EE0BL, 0xA088EE95L, 0x79A8FC39L, 0xB502FCA7L,
+        0x3B8DFB44L, 0xF727FBDAL, 0xFDE2F2C3L, 0x3148F25DL, 0xBFC7F5BEL,
+        0x736DF520L, 0xD6F6D6A7L, 0x1A5CD639L, 0x94D3D1DAL, 0x5879D144L,
+        0x52BCD85DL, 0x9E16D8C3L, 0x1099DF20L, 0xDC33DFBEL, 0x0513CD12L,
+        0xC9B9CD8CL, 0x4736CA6FL, 0x8B9CCAF1L, 0x8159C3E8L, 0x4DF3C376L,
+        0xC37CC495L, 0x0FD6C40BL, 0x7AA64737L, 0xB60C47A9L, 0x3883404AL,
+        0xF42940D4L, 0xFEEC49CDL, 0x32464953L, 0xBCC94EB0L, 0x70634E2EL,
+        0xA9435C82L, 0x65E95C1CL, 0xEB665BFFL, 0x27CC5B61L, 0x2D095278L,
+        0xE1A352E6L, 0x6F2C5505L, 0xA386559BL, 0x061D761CL, 0xCAB77682L,
+        0x44387161L, 0x889271FFL, 0x825778E6L, 0x4EFD7878L, 0xC0727F9BL,
+        0x0CD87F05L, 0xD5F86DA9L, 0x19526D37L, 0x97DD6AD4L, 0x5B776A4AL,
+        0x51B26353L, 0x9D1863CDL, 0x1397642EL, 0xDF3D64B0L, 0x83D02561L,
+        0x4F7A25FFL, 0xC1F5221CL, 0x0D5F2282L, 0x079A2B9BL, 0xCB302B05L,
+        0x45BF2CE6L, 0x89152C78L, 0x50353ED4L, 0x9C9F3E4AL, 0x121039A9L,
+        0xDEBA3937L, 0xD47F302EL, 0x18D530B0L, 0x965A3753L, 0x5AF037CDL,
+        0xFF6B144AL, 0x33C114D4L, 0xBD4E1337L, 0x71E413A9L, 0x7B211AB0L,
+        0xB78B1A2EL, 0x39041DCDL, 0xF5AE1D53L, 0x2C8E0FFFL, 0xE0240F61L,
+        0x6EAB0882L, 0xA201081CL, 0xA8C40105L, 0x646E019BL, 0xEAE10678L,
+        0x264B06E6L
+      },
+      {
+        0x00000000L, 0x177B1443L, 0x2EF62886L, 0x398D3CC5L, 0x5DEC510CL,
+        0x4A97454FL, 0x731A798AL, 0x64616DC9L, 0xBBD8A218L, 0xACA3B65BL,
+        0x952E8A9EL, 0x82559EDDL, 0xE634F314L, 0xF14FE757L, 0xC8C2DB92L,
+        0xDFB9CFD1L, 0xACC04271L, 0xBBBB5632L, 0x82366AF7L, 0x954D7EB4L,
+        0xF12C137DL, 0xE657073EL, 0xDFDA3BFBL, 0xC8A12FB8L, 0x1718E069L,
+        0x0063F42AL, 0x39EEC8EFL, 0x2E95DCACL, 0x4AF4B165L, 0x5D8FA526L,
+        0x640299E3L, 0x73798DA0L, 0x82F182A3L, 0x958A96E0L, 0xAC07AA25L,
+        0xBB7CBE66L, 0xDF1DD3AFL, 0xC866C7ECL, 0xF1EBFB29L, 0xE690EF6AL,
+        0x392920BBL, 0x2E5234F8L, 0x17DF083DL, 0x00A41C7EL, 0x64C571B7L,
+        0x73BE65F4L, 0x4A335931L, 0x5D484D72L, 0x2E31C0D2L, 0x394AD491L,
+        0x00C7E854L, 0x17BCFC17L, 0x73DD91DEL, 0x64A6859DL, 0x5D2BB958L,
+        0x4A50AD1BL, 0x95E962CAL, 0x82927689L, 0xBB1F4A4CL, 0xAC645E0FL,
+        0xC80533C6L, 0xDF7E2785L, 0xE6F31B40L, 0xF1880F03L, 0xDE920307L,
+        0xC9E91744L, 0xF0642B81L, 0xE71F3FC2L, 0x837E520BL, 0x94054648L,
+        0xAD887A8DL, 0xBAF36ECEL, 0x654AA11FL, 0x7231B55CL, 0x4BBC8999L,
+        0x5CC79DDAL, 0x38A6F013L, 0x2FDDE450L, 0x1650D895L, 0x012BCCD6L,
+        0x72524176L, 0x65295535L, 0x5CA469F0L, 0x4BDF7DB3L, 0x2FBE107AL,
+        0x38C50439L, 0x014838FCL, 0x16332CBFL, 0xC98AE36EL, 0xDEF1F72DL,
+        0xE77CCBE8L, 0xF007DFABL, 0x9466B262L, 0x831DA621L, 0xBA909AE4L,
+        0xADEB8EA7L, 0x5C6381A4L, 0x4B1895E7L, 0x7295A922L, 0x65EEBD61L,
+        0x018FD0A8L, 0x16F4C4EBL, 0x2F79F82EL, 0x3802EC6DL, 0xE7BB23BCL,
+        0xF0C037FFL, 0xC94D0B3AL, 0xDE361F79L, 0xBA5772B0L, 0xAD2C66F3L,
+        0x94A15A36L, 0x83DA4E75L, 0xF0A3C3D5L, 0xE7D8D796L, 0xDE55EB53L,
+        0xC92EFF10L, 0xAD4F92D9L, 0xBA34869AL, 0x83B9BA5FL, 0x94C2AE1CL,
+        0x4B7B61CDL, 0x5C00758EL, 0x658D494BL, 0x72F65D08L, 0x169730C1L,
+        0x01EC2482L, 0x38611847L, 0x2F1A0C04L, 0x6655004FL, 0x712E140CL,
+        0x48A328C9L, 0x5FD83C8AL, 0x3BB95143L, 0x2CC24500L, 0x154F79C5L,
+        0x02346D86L, 0xDD8DA257L, 0xCAF6B614L, 0xF37B8AD1L, 0xE4009E92L,
+        0x8061F35BL, 0x971AE718L, 0xAE97DBDDL, 0xB9ECCF9EL, 0xCA95423EL,
+        0xDDEE567DL, 0xE4636AB8L, 0xF3187EFBL, 0x97791332L, 0x80020771L,
+        0xB98F3BB4L, 0xAEF42FF7L, 0x714DE026L, 0x6636F465L, 0x5FBBC8A0L,
+        0x48C0DCE3L, 0x2CA1B12AL, 0x3BDAA569L, 0x025799ACL, 0x152C8DEFL,
+        0xE4A482ECL, 0xF3DF96AFL, 0xCA52AA6AL, 0xDD29BE29L, 0xB948D3E0L,
+        0xAE33C7A3L, 0x97BEFB66L, 0x80C5EF25L, 0x5F7C20F4L, 0x480734B7L,
+        0x718A0872L, 0x66F11C31L, 0x029071F8L, 0x15EB65BBL, 0x2C66597EL,
+        0x3B1D4D3DL, 0x4864C09DL, 0x5F1FD4DEL, 0x6692E81BL, 0x71E9FC58L,
+        0x15889191L, 0x02F385D2L, 0x3B7EB917L, 0x2C05AD54L, 0xF3BC6285L,
+        0xE4C776C6L, 0xDD4A4A03L, 0xCA315E40L, 0xAE503389L, 0xB92B27CAL,
+        0x80A61B0FL, 0x97DD0F4CL, 0xB8C70348L, 0xAFBC170BL, 0x96312BCEL,
+        0x814A3F8DL, 0xE52B5244L, 0xF2504607L, 0xCBDD7AC2L, 0xDCA66E81L,
+        0x031FA150L, 0x1464B513L, 0x2DE989D6L, 0x3A929D95L, 0x5EF3F05CL,
+        0x4988E41FL, 0x7005D8DAL, 0x677ECC99L, 0x14074139L, 0x037C557AL,
+        0x3AF169BFL, 0x2D8A7DFCL, 0x49EB1035L, 0x5E900476L, 0x671D38B3L,
+        0x70662CF0L, 0xAFDFE321L, 0xB8A4F762L, 0x8129CBA7L, 0x9652DFE4L,
+        0xF233B22DL, 0xE548A66EL, 0xDCC59AABL, 0xCBBE8EE8L, 0x3A3681EBL,
+        0x2D4D95A8L, 0x14C0A96DL, 0x03BBBD2EL, 0x67DAD0E7L, 0x70A1C4A4L,
+        0x492CF861L, 0x5E57EC22L, 0x81EE23F3L, 0x969537B0L, 0xAF180B75L,
+        0xB8631F36L, 0xDC0272FFL, 0xCB7966BCL, 0xF2F45A79L, 0xE58F4E3AL,
+        0x96F6C39AL, 0x818DD7D9L, 0xB800EB1CL, 0xAF7BFF5FL, 0xCB1A9296L,
+        0xDC6186D5L, 0xE5ECBA10L, 0xF297AE53L, 0x2D2E6182L, 0x3A5575C1L,
+        0x03D84904L, 0x14A35D47L, 0x70C2308EL, 0x67B924CDL, 0x5E341808L,
+        0x494F0C4BL
+      },
+      {
+        0x00000000L, 0xEFC26B3EL, 0x04F5D03DL, 0xEB37BB03L, 0x09EBA07AL,
+        0xE629CB44L, 0x0D1E7047L, 0xE2DC1B79L, 0x13D740F4L, 0xFC152BCAL,
+        0x172290C9L, 0xF8E0FBF7L, 0x1A3CE08EL, 0xF5FE8BB0L, 0x1EC930B3L,
+        0xF10B5B8DL, 0x27AE81E8L, 0xC86CEAD6L, 0x235B51D5L, 0xCC993AEBL,
+        0x2E452192L, 0xC1874AACL, 0x2AB0F1AFL, 0xC5729A91L, 0x3479C11CL,
+        0xDBBBAA22L, 0x308C1121L, 0xDF4E7A1FL, 0x3D926166L, 0xD2500A58L,
+        0x3967B15BL, 0xD6A5DA65L, 0x4F5D03D0L, 0xA09F68EEL, 0x4BA8D3EDL,
+        0xA46AB8D3L, 0x46B6A3AAL, 0xA974C894L, 0x42437397L, 0xAD8118A9L,
+        0x5C8A4324L, 0xB348281AL, 0x587F9319L, 0xB7BDF827L, 0x5561E35EL,
+        0xBAA38860L, 0x51943363L, 0xBE56585DL, 0x68F38238L, 0x8731E906L,
+        0x6C065205L, 0x83C4393BL, 0x61182242L, 0x8EDA497CL, 0x65EDF27FL,
+        0x8A2F9941L, 0x7B24C2CCL, 0x94E6A9F2L, 0x7FD112F1L, 0x901379CFL,
+        0x72CF62B6L, 0x9D0D0988L, 0x763AB28BL, 0x99F8D9B5L, 0x9EBA07A0L,
+        0x71786C9EL, 0x9A4FD79DL, 0x758DBCA3L, 0x9751A7DAL, 0x7893CCE4L,
+        0x93A477E7L, 0x7C661CD9L, 0x8D6D4754L, 0x62AF2C6AL, 0x89989769L,
+        0x665AFC57L, 0x8486E72EL, 0x6B448C10L, 0x80733713L, 0x6FB15C2DL,
+        0xB9148648L, 0x56D6ED76L, 0xBDE15675L, 0x52233D4BL, 0xB0FF2632L,
+        0x5F3D4D0CL, 0xB40AF60FL, 0x5BC89D31L, 0xAAC3C6BCL, 0x4501AD82L,
+        0xAE361681L, 0x41F47DBFL, 0xA32866C6L, 0x4CEA0DF8L, 0xA7DDB6FBL,
+        0x481FDDC5L, 0xD1E70470L, 0x3E256F4EL, 0xD512D44DL, 0x3AD0BF73L,
+        0xD80CA40AL, 0x37CECF34L, 0xDCF97437L, 0x333B1F09L, 0xC2304484L,
+        0x2DF22FBAL, 0xC6C594B9L, 0x2907FF87L, 0xCBDBE4FEL, 0x24198FC0L,
+        0xCF2E34C3L, 0x20EC5FFDL, 0xF6498598L, 0x198BEEA6L, 0xF2BC55A5L,
+        0x1D7E3E9BL, 0xFFA225E2L, 0x10604EDCL, 0xFB57F5DFL, 0x14959EE1L,
+        0xE59EC56CL, 0x0A5CAE52L, 0xE16B1551L, 0x0EA97E6FL, 0xEC756516L,
+        0x03B70E28L, 0xE880B52BL, 0x0742DE15L, 0xE6050901L, 0x09C7623FL,
+        0xE2F0D93CL, 0x0D32B202L, 0xEFEEA97BL, 0x002CC245L, 0xEB1B7946L,
+        0x04D91278L, 0xF5D249F5L, 0x1A1022CBL, 0xF12799C8L, 0x1EE5F2F6L,
+        0xFC39E98FL, 0x13FB82B1L, 0xF8CC39B2L, 0x170E528CL, 0xC1AB88E9L,
+        0x2E69E3D7L, 0xC55E58D4L, 0x2A9C33EAL, 0xC8402893L, 0x278243ADL,
+        0xCCB5F8AEL, 0x23779390L, 0xD27CC81DL, 0x3DBEA323L, 0xD6891820L,
+        0x394B731EL, 0xDB976867L, 0x34550359L, 0xDF62B85AL, 0x30A0D364L,
+        0xA9580AD1L, 0x469A61EFL, 0xADADDAECL, 0x426FB1D2L, 0xA0B3AAABL,
+        0x4F71C195L, 0xA4467A96L, 0x4B8411A8L, 0xBA8F4A25L, 0x554D211BL,
+        0xBE7A9A18L, 0x51B8F126L, 0xB364EA5FL, 0x5CA68161L, 0xB7913A62L,
+        0x5853515CL, 0x8EF68B39L, 0x6134E007L, 0x8A035B04L, 0x65C1303AL,
+        0x871D2B43L, 0x68DF407DL, 0x83E8FB7EL, 0x6C2A9040L, 0x9D21CBCDL,
+        0x72E3A0F3L, 0x99D41BF0L, 0x761670CEL, 0x94CA6BB7L, 0x7B080089L,
+        0x903FBB8AL, 0x7FFDD0B4L, 0x78BF0EA1L, 0x977D659FL, 0x7C4ADE9CL,
+        0x9388B5A2L, 0x7154AEDBL, 0x9E96C5E5L, 0x75A17EE6L, 0x9A6315D8L,
+        0x6B684E55L, 0x84AA256BL, 0x6F9D9E68L, 0x805FF556L, 0x6283EE2FL,
+        0x8D418511L, 0x66763E12L, 0x89B4552CL, 0x5F118F49L, 0xB0D3E477L,
+        0x5BE45F74L, 0xB426344AL, 0x56FA2F33L, 0xB938440DL, 0x520FFF0EL,
+        0xBDCD9430L, 0x4CC6CFBDL, 0xA304A483L, 0x48331F80L, 0xA7F174BEL,
+        0x452D6FC7L, 0xAAEF04F9L, 0x41D8BFFAL, 0xAE1AD4C4L, 0x37E20D71L,
+        0xD820664FL, 0x3317DD4CL, 0xDCD5B672L, 0x3E09AD0BL, 0xD1CBC635L,
+        0x3AFC7D36L, 0xD53E1608L, 0x24354D85L, 0xCBF726BBL, 0x20C09DB8L,
+        0xCF02F686L, 0x2DDEEDFFL, 0xC21C86C1L, 0x292B3DC2L, 0xC6E956FCL,
+        0x104C8C99L, 0xFF8EE7A7L, 0x14B95CA4L, 0xFB7B379AL, 0x19A72CE3L,
+        0xF66547DDL, 0x1D52FCDEL, 0xF29097E0L, 0x039BCC6DL, 0xEC59A753L,
+        0x076E1C50L, 0xE8AC776EL, 0x0A706C17L, 0xE5B20729L, 0x0E85BC2AL,
+        0xE147D714L
+      },
+      {
+        0x00000000L, 0xC18EDFC0L, 0x586CB9C1L, 0x99E26601L, 0xB0D97382L,
+        0x7157AC42L, 0xE8B5CA43L, 0x293B1583L, 0xBAC3E145L, 0x7B4D3E85L,
+        0xE2AF5884L, 0x23218744L, 0x0A1A92C7L, 0xCB944D07L, 0x52762B06L,
+        0x93F8F4C6L, 0xAEF6C4CBL, 0x6F781B0BL, 0xF69A7D0AL, 0x3714A2CAL,
+        0x1E2FB749L, 0xDFA16889L, 0x46430E88L, 0x87CDD148L, 0x1435258EL,
+        0xD5BBFA4EL, 0x4C599C4FL, 0x8DD7438FL, 0xA4EC560CL, 0x656289CCL,
+        0xFC80EFCDL, 0x3D0E300DL, 0x869C8FD7L, 0x47125017L, 0xDEF03616L,
+        0x1F7EE9D6L, 0x3645FC55L, 0xF7CB2395L, 0x6E294594L, 0xAFA79A54L,
+        0x3C5F6E92L, 0xFDD1B152L, 0x6433D753L, 0xA5BD0893L, 0x8C861D10L,
+        0x4D08C2D0L, 0xD4EAA4D1L, 0x15647B11L, 0x286A4B1CL, 0xE9E494DCL,
+        0x7006F2DDL, 0xB1882D1DL, 0x98B3389EL, 0x593DE75EL, 0xC0DF815FL,
+        0x01515E9FL, 0x92A9AA59L, 0x53277599L, 0xCAC51398L, 0x0B4BCC58L,
+        0x2270D9DBL, 0xE3FE061BL, 0x7A1C601AL, 0xBB92BFDAL, 0xD64819EFL,
+        0x17C6C62FL, 0x8E24A02EL, 0x4FAA7FEEL, 0x66916A6DL, 0xA71FB5ADL,
+        0x3EFDD3ACL, 0xFF730C6CL, 0x6C8BF8AAL, 0xAD05276AL, 0x34E7416BL,
+        0xF5699EABL, 0xDC528B28L, 0x1DDC54E8L, 0x843E32E9L, 0x45B0ED29L,
+        0x78BEDD24L, 0xB93002E4L, 0x20D264E5L, 0xE15CBB25L, 0xC867AEA6L,
+        0x09E97166L, 0x900B1767L, 0x5185C8A7L, 0xC27D3C61L, 0x03F3E3A1L,
+        0x9A1185A0L, 0x5B9F5A60L, 0x72A44FE3L, 0xB32A9023L, 0x2AC8F622L,
+        0xEB4629E2L, 0x50D49638L, 0x915A49F8L, 0x08B82FF9L, 0xC936F039L,
+        0xE00DE5BAL, 0x21833A7AL, 0xB8615C7BL, 0x79EF83BBL, 0xEA17777DL,
+        0x2B99A8BDL, 0xB27BCEBCL, 0x73F5117CL, 0x5ACE04FFL, 0x9B40DB3FL,
+        0x02A2BD3EL, 0xC32C62FEL, 0xFE2252F3L, 0x3FAC8D33L, 0xA64EEB32L,
+        0x67C034F2L, 0x4EFB2171L, 0x8F75FEB1L, 0x169798B0L, 0xD7194770L,
+        0x44E1B3B6L, 0x856F6C76L, 0x1C8D0A77L, 0xDD03D5B7L, 0xF438C034L,
+        0x35B61FF4L, 0xAC5479F5L, 0x6DDAA635L, 0x77E1359FL, 0xB66FEA5FL,
+        0x2F8D8C5EL, 0xEE03539EL, 0xC738461DL, 0x06B699DDL, 0x9F54FFDCL,
+        0x5EDA201CL, 0xCD22D4DAL, 0x0CAC0B1AL, 0x954E6D1BL, 0x54C0B2DBL,
+        0x7DFBA758L, 0xBC757898L, 0x25971E99L, 0xE419C159L, 0xD917F154L,
+        0x18992E94L, 0x817B4895L, 0x40F59755L, 0x69CE82D6L, 0xA8405D16L,
+        0x31A23B17L, 0xF02CE4D7L, 0x63D41011L, 0xA25ACFD1L, 0x3BB8A9D0L,
+        0xFA367610L, 0xD30D6393L, 0x1283BC53L, 0x8B61DA52L, 0x4AEF0592L,
+        0xF17DBA48L, 0x30F36588L, 0xA9110389L, 0x689FDC49L, 0x41A4C9CAL,
+        0x802A160AL, 0x19C8700BL, 0xD846AFCBL, 0x4BBE5B0DL, 0x8A3084CDL,
+        0x13D2E2CCL, 0xD25C3D0CL, 0xFB67288FL, 0x3AE9F74FL, 0xA30B914EL,
+        0x62854E8EL, 0x5F8B7E83L, 0x9E05A143L, 0x07E7C742L, 0xC6691882L,
+        0xEF520D01L, 0x2EDCD2C1L, 0xB73EB4C0L, 0x76B06B00L, 0xE5489FC6L,
+        0x24C64006L, 0xBD242607L, 0x7CAAF9C7L, 0x5591EC44L, 0x941F3384L,
+        0x0DFD5585L, 0xCC738A45L, 0xA1A92C70L, 0x6027F3B0L, 0xF9C595B1L,
+        0x384B4A71L, 0x11705FF2L, 0xD0FE8032L, 0x491CE633L, 0x889239F3L,
+        0x1B6ACD35L, 0xDAE412F5L, 0x430674F4L, 0x8288AB34L, 0xABB3BEB7L,
+        0x6A3D6177L, 0xF3DF0776L, 0x3251D8B6L, 0x0F5FE8BBL, 0xCED1377BL,
+        0x5733517AL, 0x96BD8EBAL, 0xBF869B39L, 0x7E0844F9L, 0xE7EA22F8L,
+        0x2664FD38L, 0xB59C09FEL, 0x7412D63EL, 0xEDF0B03FL, 0x2C7E6FFFL,
+        0x05457A7CL, 0xC4CBA5BCL, 0x5D29C3BDL, 0x9CA71C7DL, 0x2735A3A7L,
+        0xE6BB7C67L, 0x7F591A66L, 0xBED7C5A6L, 0x97ECD025L, 0x56620FE5L,
+        0xCF8069E4L, 0x0E0EB624L, 0x9DF642E2L, 0x5C789D22L, 0xC59AFB23L,
+        0x041424E3L, 0x2D2F3160L, 0xECA1EEA0L, 0x754388A1L, 0xB4CD5761L,
+        0x89C3676CL, 0x484DB8ACL, 0xD1AFDEADL, 0x1021016DL, 0x391A14EEL,
+        0xF894CB2EL, 0x6176AD2FL, 0xA0F872EFL, 0x33008629L, 0xF28E59E9L,
+        0x6B6C3FE8L, 0xAAE2E028L, 0x83D9F5ABL, 0x42572A6BL, 0xDBB54C6AL,
+        0x1A3B93AAL
+      },
+      {
+        0x00000000L, 0x9BA54C6FL, 0xEC3B9E9FL, 0x779ED2F0L, 0x03063B7FL,
+        0x98A37710L, 0xEF3DA5E0L, 0x7498E98FL, 0x060C76FEL, 0x9DA93A91L,
+        0xEA37E861L, 0x7192A40EL, 0x050A4D81L, 0x9EAF01EEL, 0xE931D31EL,
+        0x72949F71L, 0x0C18EDFCL, 0x97BDA193L, 0xE0237363L, 0x7B863F0CL,
+        0x0F1ED683L, 0x94BB9AECL, 0xE325481CL, 0x78800473L, 0x0A149B02L,
+        0x91B1D76DL, 0xE62F059DL, 0x7D8A49F2L, 0x0912A07DL, 0x92B7EC12L,
+        0xE5293EE2L, 0x7E8C728DL, 0x1831DBF8L, 0x83949797L, 0xF40A4567L,
+        0x6FAF0908L, 0x1B37E087L, 0x8092ACE8L, 0xF70C7E18L, 0x6CA93277L,
+        0x1E3DAD06L, 0x8598E169L, 0xF2063399L, 0x69A37FF6L, 0x1D3B9679L,
+        0x869EDA16L, 0xF10008E6L, 0x6AA54489L, 0x14293604L, 0x8F8C7A6BL,
+        0xF812A89BL, 0x63B7E4F4L, 0x172F0D7BL, 0x8C8A4114L, 0xFB1493E4L,
+        0x60B1DF8BL, 0x122540FAL, 0x89800C95L, 0xFE1EDE65L, 0x65BB920AL,
+        0x11237B85L, 0x8A8637EAL, 0xFD18E51AL, 0x66BDA975L, 0x3063B7F0L,
+        0xABC6FB9FL, 0xDC58296FL, 0x47FD6500L, 0x33658C8FL, 0xA8C0C0E0L,
+        0xDF5E1210L, 0x44FB5E7FL, 0x366FC10EL, 0xADCA8D61L, 0xDA545F91L,
+        0x41F113FEL, 0x3569FA71L, 0xAECCB61EL, 0xD95264EEL, 0x42F72881L,
+        0x3C7B5A0CL, 0xA7DE1663L, 0xD040C493L, 0x4BE588FCL, 0x3F7D6173L,
+        0xA4D82D1CL, 0xD346FFECL, 0x48E3B383L, 0x3A772CF2L, 0xA1D2609DL,
+        0xD64CB26DL, 0x4DE9FE02L, 0x3971178DL, 0xA2D45BE2L, 0xD54A8912L,
+        0x4EEFC57DL, 0x28526C08L, 0xB3F72067L, 0xC469F297L, 0x5FCCBEF8L,
+        0x2B545777L, 0xB0F11B18L, 0xC76FC9E8L, 0x5CCA8587L, 0x2E5E1AF6L,
+        0xB5FB5699L, 0xC2658469L, 0x59C0C806L, 0x2D582189L, 0xB6FD6DE6L,
+        0xC163BF16L, 0x5AC6F379L, 0x244A81F4L, 0xBFEFCD9BL, 0xC8711F6BL,
+        0x53D45304L, 0x274CBA8BL, 0xBCE9F6E4L, 0xCB772414L, 0x50D2687BL,
+        0x2246F70AL, 0xB9E3BB65L, 0xCE7D6995L, 0x55D825FAL, 0x2140CC75L,
+        0xBAE5801AL, 0xCD7B52EAL, 0x56DE1E85L, 0x60C76FE0L, 0xFB62238FL,
+        0x8CFCF17FL, 0x1759BD10L, 0x63C1549FL, 0xF86418F0L, 0x8FFACA00L,
+        0x145F866FL, 0x66CB191EL, 0xFD6E5571L, 0x8AF08781L, 0x1155CBEEL,
+        0x65CD2261L, 0xFE686E0EL, 0x89F6BCFEL, 0x1253F091L, 0x6CDF821CL,
+        0xF77ACE73L, 0x80E41C83L, 0x1B4150ECL, 0x6FD9B963L, 0xF47CF50CL,
+        0x83E227FCL, 0x18476B93L, 0x6AD3F4E2L, 0xF176B88DL, 0x86E86A7DL,
+        0x1D4D2612L, 0x69D5CF9DL, 0xF27083F2L, 0x85EE5102L, 0x1E4B1D6DL,
+        0x78F6B418L, 0xE353F877L, 0x94CD2A87L, 0x0F6866E8L, 0x7BF08F67L,
+        0xE055C308L, 0x97CB11F8L, 0x0C6E5D97L, 0x7EFAC2E6L, 0xE55F8E89L,
+        0x92C15C79L, 0x09641016L, 0x7DFCF999L, 0xE659B5F6L, 0x91C76706L,
+        0x0A622B69L, 0x74EE59E4L, 0xEF4B158BL, 0x98D5C77BL, 0x03708B14L,
+        0x77E8629BL, 0xEC4D2EF4L, 0x9BD3FC04L, 0x0076B06BL, 0x72E22F1AL,
+        0xE9476375L, 0x9ED9B185L, 0x057CFDEAL, 0x71E41465L, 0xEA41580AL,
+        0x9DDF8AFAL, 0x067AC695L, 0x50A4D810L, 0xCB01947FL, 0xBC9F468FL,
+        0x273A0AE0L, 0x53A2E36FL, 0xC807AF00L, 0xBF997DF0L, 0x243C319FL,
+        0x56A8AEEEL, 0xCD0DE281L, 0xBA933071L, 0x21367C1EL, 0x55AE9591L,
+        0xCE0BD9FEL, 0xB9950B0EL, 0x22304761L, 0x5CBC35ECL, 0xC7197983L,
+        0xB087AB73L, 0x2B22E71CL, 0x5FBA0E93L, 0xC41F42FCL, 0xB381900CL,
+        0x2824DC63L, 0x5AB04312L, 0xC1150F7DL, 0xB68BDD8DL, 0x2D2E91E2L,
+        0x59B6786DL, 0xC2133402L, 0xB58DE6F2L, 0x2E28AA9DL, 0x489503E8L,
+        0xD3304F87L, 0xA4AE9D77L, 0x3F0BD118L, 0x4B933897L, 0xD03674F8L,
+        0xA7A8A608L, 0x3C0DEA67L, 0x4E997516L, 0xD53C3979L, 0xA2A2EB89L,
+        0x3907A7E6L, 0x4D9F4E69L, 0xD63A0206L, 0xA1A4D0F6L, 0x3A019C99L,
+        0x448DEE14L, 0xDF28A27BL, 0xA8B6708BL, 0x33133CE4L, 0x478BD56BL,
+        0xDC2E9904L, 0xABB04BF4L, 0x3015079BL, 0x428198EAL, 0xD924D485L,
+        0xAEBA0675L, 0x351F4A1AL, 0x4187A395L, 0xDA22EFFAL, 0xADBC3D0AL,
+        0x36197165L
+      },
+      {
+        0x00000000L, 0xDD96D985L, 0x605CB54BL, 0xBDCA6CCEL, 0xC0B96A96L,
+        0x1D2FB313L, 0xA0E5DFDDL, 0x7D730658L, 0x5A03D36DL, 0x87950AE8L,
+        0x3A5F6626L, 0xE7C9BFA3L, 0x9ABAB9FBL, 0x472C607EL, 0xFAE60CB0L,
+        0x2770D535L, 0xB407A6DAL, 0x69917F5FL, 0xD45B1391L, 0x09CDCA14L,
+        0x74BECC4CL, 0xA92815C9L, 0x14E27907L, 0xC974A082L, 0xEE0475B7L,
+        0x3392AC32L, 0x8E58C0FCL, 0x53CE1979L, 0x2EBD1F21L, 0xF32BC6A4L,
+        0x4EE1AA6AL, 0x937773EFL, 0xB37E4BF5L, 0x6EE89270L, 0xD322FEBEL,
+        0x0EB4273BL, 0x73C72163L, 0xAE51F8E6L, 0x139B9428L, 0xCE0D4DADL,
+        0xE97D9898L, 0x34EB411DL, 0x89212DD3L, 0x54B7F456L, 0x29C4F20EL,
+        0xF4522B8BL, 0x49984745L, 0x940E9EC0L, 0x0779ED2FL, 0xDAEF34AAL,
+        0x67255864L, 0xBAB381E1L, 0xC7C087B9L, 0x1A565E3CL, 0xA79C32F2L,
+        0x7A0AEB77L, 0x5D7A3E42L, 0x80ECE7C7L, 0x3D268B09L, 0xE0B0528CL,
+        0x9DC354D4L, 0x40558D51L, 0xFD9FE19FL, 0x2009381AL, 0xBD8D91ABL,
+        0x601B482EL, 0xDDD124E0L, 0x0047FD65L, 0x7D34FB3DL, 0xA0A222B8L,
+        0x1D684E76L, 0xC0FE97F3L, 0xE78E42C6L, 0x3A189B43L, 0x87D2F78DL,
+        0x5A442E08L, 0x27372850L, 0xFAA1F1D5L, 0x476B9D1BL, 0x9AFD449EL,
+        0x098A3771L, 0xD41CEEF4L, 0x69D6823AL, 0xB4405BBFL, 0xC9335DE7L,
+        0x14A58462L, 0xA96FE8ACL, 0x74F93129L, 0x5389E41CL, 0x8E1F3D99L,
+        0x33D55157L, 0xEE4388D2L, 0x93308E8AL, 0x4EA6570FL, 0xF36C3BC1L,
+        0x2EFAE244L, 0x0EF3DA5EL, 0xD36503DBL, 0x6EAF6F15L, 0xB339B690L,
+        0xCE4AB0C8L, 0x13DC694DL, 0xAE160583L, 0x7380DC06L, 0x54F00933L,
+        0x8966D0B6L, 0x34ACBC78L, 0xE93A65FDL, 0x944963A5L, 0x49DFBA20L,
+        0xF415D6EEL, 0x29830F6BL, 0xBAF47C84L, 0x6762A501L, 0xDAA8C9CFL,
+        0x073E104AL, 0x7A4D1612L, 0xA7DBCF97L, 0x1A11A359L, 0xC7877ADCL,
+        0xE0F7AFE9L, 0x3D61766CL, 0x80AB1AA2L, 0x5D3DC327L, 0x204EC57FL,
+        0xFDD81CFAL, 0x40127034L, 0x9D84A9B1L, 0xA06A2517L, 0x7DFCFC92L,
+        0xC036905CL, 0x1DA049D9L, 0x60D34F81L, 0xBD459604L, 0x008FFACAL,
+        0xDD19234FL, 0xFA69F67AL, 0x27FF2FFFL, 0x9A354331L, 0x47A39AB4L,
+        0x3AD09CECL, 0xE7464569L, 0x5A8C29A7L, 0x871AF022L, 0x146D83CDL,
+        0xC9FB5A48L, 0x74313686L, 0xA9A7EF03L, 0xD4D4E95BL, 0x094230DEL,
+        0xB4885C10L, 0x691E8595L, 0x4E6E50A0L, 0x93F88925L, 0x2E32E5EBL,
+        0xF3A43C6EL, 0x8ED73A36L, 0x5341E3B3L, 0xEE8B8F7DL, 0x331D56F8L,
+        0x13146EE2L, 0xCE82B767L, 0x7348DBA9L, 0xAEDE022CL, 0xD3AD0474L,
+        0x0E3BDDF1L, 0xB3F1B13FL, 0x6E6768BAL, 0x4917BD8FL, 0x9481640AL,
+        0x294B08C4L, 0xF4DDD141L, 0x89AED719L, 0x54380E9CL, 0xE9F26252L,
+        0x3464BBD7L, 0xA713C838L, 0x7A8511BDL, 0xC74F7D73L, 0x1AD9A4F6L,
+        0x67AAA2AEL, 0xBA3C7B2BL, 0x07F617E5L, 0xDA60CE60L, 0xFD101B55L,
+        0x2086C2D0L, 0x9D4CAE1EL, 0x40DA779BL, 0x3DA971C3L, 0xE03FA846L,
+        0x5DF5C488L, 0x80631D0DL, 0x1DE7B4BCL, 0xC0716D39L, 0x7DBB01F7L,
+        0xA02DD872L, 0xDD5EDE2AL, 0x00C807AFL, 0xBD026B61L, 0x6094B2E4L,
+        0x47E467D1L, 0x9A72BE54L, 0x27B8D29AL, 0xFA2E0B1FL, 0x875D0D47L,
+        0x5ACBD4C2L, 0xE701B80CL, 0x3A976189L, 0xA9E01266L, 0x7476CBE3L,
+        0xC9BCA72DL, 0x142A7EA8L, 0x695978F0L, 0xB4CFA175L, 0x0905CDBBL,
+        0xD493143EL, 0xF3E3C10BL, 0x2E75188EL, 0x93BF7440L, 0x4E29ADC5L,
+        0x335AAB9DL, 0xEECC7218L, 0x53061ED6L, 0x8E90C753L, 0xAE99FF49L,
+        0x730F26CCL, 0xCEC54A02L, 0x13539387L, 0x6E2095DFL, 0xB3B64C5AL,
+        0x0E7C2094L, 0xD3EAF911L, 0xF49A2C24L, 0x290CF5A1L, 0x94C6996FL,
+        0x495040EAL, 0x342346B2L, 0xE9B59F37L, 0x547FF3F9L, 0x89E92A7CL,
+        0x1A9E5993L, 0xC7088016L, 0x7AC2ECD8L, 0xA754355DL, 0xDA273305L,
+        0x07B1EA80L, 0xBA7B864EL, 0x67ED5FCBL, 0x409D8AFEL, 0x9D0B537BL,
+        0x20C13FB5L, 0xFD57E630L, 0x8024E068L, 0x5DB239EDL, 0xE0785523L,
+        0x3DEE8CA6L
+      },
+      {
+        0x00000000L, 0x9D0FE176L, 0xE16EC4ADL, 0x7C6125DBL, 0x19AC8F1BL,
+        0x84A36E6DL, 0xF8C24BB6L, 0x65CDAAC0L, 0x33591E36L, 0xAE56FF40L,
+        0xD237DA9BL, 0x4F383BEDL, 0x2AF5912DL, 0xB7FA705BL, 0xCB9B5580L,
+        0x5694B4F6L, 0x66B23C6CL, 0xFBBDDD1AL, 0x87DCF8C1L, 0x1AD319B7L,
+        0x7F1EB377L, 0xE2115201L, 0x9E7077DAL, 0x037F96ACL, 0x55EB225AL,
+        0xC8E4C32CL, 0xB485E6F7L, 0x298A0781L, 0x4C47AD41L, 0xD1484C37L,
+        0xAD2969ECL, 0x3026889AL, 0xCD6478D8L, 0x506B99AEL, 0x2C0ABC75L,
+        0xB1055D03L, 0xD4C8F7C3L, 0x49C716B5L, 0x35A6336EL, 0xA8A9D218L,
+        0xFE3D66EEL, 0x63328798L, 0x1F53A243L, 0x825C4335L, 0xE791E9F5L,
+        0x7A9E0883L, 0x06FF2D58L, 0x9BF0CC2EL, 0xABD644B4L, 0x36D9A5C2L,
+        0x4AB88019L, 0xD7B7616FL, 0xB27ACBAFL, 0x2F752AD9L, 0x53140F02L,
+        0xCE1BEE74L, 0x988F5A82L, 0x0580BBF4L, 0x79E19E2FL, 0xE4EE7F59L,
+        0x8123D599L, 0x1C2C34EFL, 0x604D1134L, 0xFD42F042L, 0x41B9F7F1L,
+        0xDCB61687L, 0xA0D7335CL, 0x3DD8D22AL, 0x581578EAL, 0xC51A999CL,
+        0xB97BBC47L, 0x24745D31L, 0x72E0E9C7L, 0xEFEF08B1L, 0x938E2D6AL,
+        0x0E81CC1CL, 0x6B4C66DCL, 0xF64387AAL, 0x8A22A271L, 0x172D4307L,
+        0x270BCB9DL, 0xBA042AEBL, 0xC6650F30L, 0x5B6AEE46L, 0x3EA74486L,
+        0xA3A8A5F0L, 0xDFC9802BL, 0x42C6615DL, 0x1452D5ABL, 0x895D34DDL,
+        0xF53C1106L, 0x6833F070L, 0x0DFE5AB0L, 0x90F1BBC6L, 0xEC909E1DL,
+        0x719F7F6BL, 0x8CDD8F29L, 0x11D26E5FL, 0x6DB34B84L, 0xF0BCAAF2L,
+        0x95710032L, 0x087EE144L, 0x741FC49FL, 0xE91025E9L, 0xBF84911FL,
+        0x228B7069L, 0x5EEA55B2L, 0xC3E5B4C4L, 0xA6281E04L, 0x3B27FF72L,
+        0x4746DAA9L, 0xDA493BDFL, 0xEA6FB345L, 0x77605233L, 0x0B0177E8L,
+        0x960E969EL, 0xF3C33C5EL, 0x6ECCDD28L, 0x12ADF8F3L, 0x8FA21985L,
+        0xD936AD73L, 0x44394C05L, 0x385869DEL, 0xA55788A8L, 0xC09A2268L,
+        0x5D95C31EL, 0x21F4E6C5L, 0xBCFB07B3L, 0x8373EFE2L, 0x1E7C0E94L,
+        0x621D2B4FL, 0xFF12CA39L, 0x9ADF60F9L, 0x07D0818FL, 0x7BB1A454L,
+        0xE6BE4522L, 0xB02AF1D4L, 0x2D2510A2L, 0x51443579L, 0xCC4BD40FL,
+        0xA9867ECFL, 0x34899FB9L, 0x48E8BA62L, 0xD5E75B14L, 0xE5C1D38EL,
+        0x78CE32F8L, 0x04AF1723L, 0x99A0F655L, 0xFC6D5C95L, 0x6162BDE3L,
+        0x1D039838L, 0x800C794EL, 0xD698CDB8L, 0x4B972CCEL, 0x37F60915L,
+        0xAAF9E863L, 0xCF3442A3L, 0x523BA3D5L, 0x2E5A860EL, 0xB3556778L,
+        0x4E17973AL, 0xD318764CL, 0xAF795397L, 0x3276B2E1L, 0x57BB1821L,
+        0xCAB4F957L, 0xB6D5DC8CL, 0x2BDA3DFAL, 0x7D4E890CL, 0xE041687AL,
+        0x9C204DA1L, 0x012FACD7L, 0x64E20617L, 0xF9EDE761L, 0x858CC2BAL,
+        0x188323CCL, 0x28A5AB56L, 0xB5AA4A20L, 0xC9CB6FFBL, 0x54C48E8DL,
+        0x3109244DL, 0xAC06C53BL, 0xD067E0E0L, 0x4D680196L, 0x1BFCB560L,
+        0x86F35416L, 0xFA9271CDL, 0x679D90BBL, 0x02503A7BL, 0x9F5FDB0DL,
+        0xE33EFED6L, 0x7E311FA0L, 0xC2CA1813L, 0x5FC5F965L, 0x23A4DCBEL,
+        0xBEAB3DC8L, 0xDB669708L, 0x4669767EL, 0x3A0853A5L, 0xA707B2D3L,
+        0xF1930625L, 0x6C9CE753L, 0x10FDC288L, 0x8DF223FEL, 0xE83F893EL,
+        0x75306848L, 0x09514D93L, 0x945EACE5L, 0xA478247FL, 0x3977C509L,
+        0x4516E0D2L, 0xD81901A4L, 0xBDD4AB64L, 0x20DB4A12L, 0x5CBA6FC9L,
+        0xC1B58EBFL, 0x97213A49L, 0x0A2EDB3FL, 0x764FFEE4L, 0xEB401F92L,
+        0x8E8DB552L, 0x13825424L, 0x6FE371FFL, 0xF2EC9089L, 0x0FAE60CBL,
+        0x92A181BDL, 0xEEC0A466L, 0x73CF4510L, 0x1602EFD0L, 0x8B0D0EA6L,
+        0xF76C2B7DL, 0x6A63CA0BL, 0x3CF77EFDL, 0xA1F89F8BL, 0xDD99BA50L,
+        0x40965B26L, 0x255BF1E6L, 0xB8541090L, 0xC435354BL, 0x593AD43DL,
+        0x691C5CA7L, 0xF413BDD1L, 0x8872980AL, 0x157D797CL, 0x70B0D3BCL,
+        0xEDBF32CAL, 0x91DE1711L, 0x0CD1F667L, 0x5A454291L, 0xC74AA3E7L,
+        0xBB2B863CL, 0x2624674AL, 0x43E9CD8AL, 0xDEE62CFCL, 0xA2870927L,
+        0x3F88E851L
+      },
+      {
+        0x00000000L, 0xB9FBDBE8L, 0xA886B191L, 0x117D6A79L, 0x8A7C6563L,
+        0x3387BE8BL, 0x22FAD4F2L, 0x9B010F1AL, 0xCF89CC87L, 0x7672176FL,
+        0x670F7D16L, 0xDEF4A6FEL, 0x45F5A9E4L, 0xFC0E720CL, 0xED731875L,
+        0x5488C39DL, 0x44629F4FL, 0xFD9944A7L, 0xECE42EDEL, 0x551FF536L,
+        0xCE1EFA2CL, 0x77E521C4L, 0x66984BBDL, 0xDF639055L, 0x8BEB53C8L,
+        0x32108820L, 0x236DE259L, 0x9A9639B1L, 0x019736ABL, 0xB86CED43L,
+        0xA911873AL, 0x10EA5CD2L, 0x88C53E9EL, 0x313EE576L, 0x20438F0FL,
+        0x99B854E7L, 0x02B95BFDL, 0xBB428015L, 0xAA3FEA6CL, 0x13C43184L,
+        0x474CF219L, 0xFEB729F1L, 0xEFCA4388L, 0x56319860L, 0xCD30977AL,
+        0x74CB4C92L, 0x65B626EBL, 0xDC4DFD03L, 0xCCA7A1D1L, 0x755C7A39L,
+        0x64211040L, 0xDDDACBA8L, 0x46DBC4B2L, 0xFF201F5AL, 0xEE5D7523L,
+        0x57A6AECBL, 0x032E6D56L, 0xBAD5B6BEL, 0xABA8DCC7L, 0x1253072FL,
+        0x89520835L, 0x30A9D3DDL, 0x21D4B9A4L, 0x982F624CL, 0xCAFB7B7DL,
+        0x7300A095L, 0x627DCAECL, 0xDB861104L, 0x40871E1EL, 0xF97CC5F6L,
+        0xE801AF8FL, 0x51FA7467L, 0x0572B7FAL, 0xBC896C12L, 0xADF4066BL,
+        0x140FDD83L, 0x8F0ED299L, 0x36F50971L, 0x27886308L, 0x9E73B8E0L,
+        0x8E99E432L, 0x37623FDAL, 0x261F55A3L, 0x9FE48E4BL, 0x04E58151L,
+        0xBD1E5AB9L, 0xAC6330C0L, 0x1598EB28L, 0x411028B5L, 0xF8EBF35DL,
+        0xE9969924L, 0x506D42CCL, 0xCB6C4DD6L, 0x7297963EL, 0x63EAFC47L,
+        0xDA1127AFL, 0x423E45E3L, 0xFBC59E0BL, 0xEAB8F472L, 0x53432F9AL,
+        0xC8422080L, 0x71B9FB68L, 0x60C49111L, 0xD93F4AF9L, 0x8DB78964L,
+        0x344C528CL, 0x253138F5L, 0x9CCAE31DL, 0x07CBEC07L, 0xBE3037EFL,
+        0xAF4D5D96L, 0x16B6867EL, 0x065CDAACL, 0xBFA70144L, 0xAEDA6B3DL,
+        0x1721B0D5L, 0x8C20BFCFL, 0x35DB6427L, 0x24A60E5EL, 0x9D5DD5B6L,
+        0xC9D5162BL, 0x702ECDC3L, 0x6153A7BAL, 0xD8A87C52L, 0x43A97348L,
+        0xFA52A8A0L, 0xEB2FC2D9L, 0x52D41931L, 0x4E87F0BBL, 0xF77C2B53L,
+        0xE601412AL, 0x5FFA9AC2L, 0xC4FB95D8L, 0x7D004E30L, 0x6C7D2449L,
+        0xD586FFA1L, 0x810E3C3CL, 0x38F5E7D4L, 0x29888DADL, 0x90735645L,
+        0x0B72595FL, 0xB28982B7L, 0xA3F4E8CEL, 0x1A0F3326L, 0x0AE56FF4L,
+        0xB31EB41CL, 0xA263DE65L, 0x1B98058DL, 0x80990A97L, 0x3962D17FL,
+        0x281FBB06L, 0x91E460EEL, 0xC56CA373L, 0x7C97789BL, 0x6DEA12E2L,
+        0xD411C90AL, 0x4F10C610L, 0xF6EB1DF8L, 0xE7967781L, 0x5E6DAC69L,
+        0xC642CE25L, 0x7FB915CDL, 0x6EC47FB4L, 0xD73FA45CL, 0x4C3EAB46L,
+        0xF5C570AEL, 0xE4B81AD7L, 0x5D43C13FL, 0x09CB02A2L, 0xB030D94AL,
+        0xA14DB333L, 0x18B668DBL, 0x83B767C1L, 0x3A4CBC29L, 0x2B31D650L,
+        0x92CA0DB8L, 0x8220516AL, 0x3BDB8A82L, 0x2AA6E0FBL, 0x935D3B13L,
+        0x085C3409L, 0xB1A7EFE1L, 0xA0DA8598L, 0x19215E70L, 0x4DA99DEDL,
+        0xF4524605L, 0xE52F2C7CL, 0x5CD4F794L, 0xC7D5F88EL, 0x7E2E2366L,
+        0x6F53491FL, 0xD6A892F7L, 0x847C8BC6L, 0x3D87502EL, 0x2CFA3A57L,
+        0x9501E1BFL, 0x0E00EEA5L, 0xB7FB354DL, 0xA6865F34L, 0x1F7D84DCL,
+        0x4BF54741L, 0xF20E9CA9L, 0xE373F6D0L, 0x5A882D38L, 0xC1892222L,
+        0x7872F9CAL, 0x690F93B3L, 0xD0F4485BL, 0xC01E1489L, 0x79E5CF61L,
+        0x6898A518L, 0xD1637EF0L, 0x4A6271EAL, 0xF399AA02L, 0xE2E4C07BL,
+        0x5B1F1B93L, 0x0F97D80EL, 0xB66C03E6L, 0xA711699FL, 0x1EEAB277L,
+        0x85EBBD6DL, 0x3C106685L, 0x2D6D0CFCL, 0x9496D714L, 0x0CB9B558L,
+        0xB5426EB0L, 0xA43F04C9L, 0x1DC4DF21L, 0x86C5D03BL, 0x3F3E0BD3L,
+        0x2E4361AAL, 0x97B8BA42L, 0xC33079DFL, 0x7ACBA237L, 0x6BB6C84EL,
+        0xD24D13A6L, 0x494C1CBCL, 0xF0B7C754L, 0xE1CAAD2DL, 0x583176C5L,
+        0x48DB2A17L, 0xF120F1FFL, 0xE05D9B86L, 0x59A6406EL, 0xC2A74F74L,
+        0x7B5C949CL, 0x6A21FEE5L, 0xD3DA250DL, 0x8752E690L, 0x3EA93D78L,
+        0x2FD45701L, 0x962F8CE9L, 0x0D2E83F3L, 0xB4D5581BL, 0xA5A83262L,
+        0x1C53E98AL
+      },
+      {
+        0x00000000L, 0xAE689191L, 0x87A02563L, 0x29C8B4F2L, 0xD4314C87L,
+        0x7A59DD16L, 0x539169E4L, 0xFDF9F875L, 0x73139F4FL, 0xDD7B0EDEL,
+        0xF4B3BA2CL, 0x5ADB2BBDL, 0xA722D3C8L, 0x094A4259L, 0x2082F6ABL,
+        0x8EEA673AL, 0xE6273E9EL, 0x484FAF0FL, 0x61871BFDL, 0xCFEF8A6CL,
+        0x32167219L, 0x9C7EE388L, 0xB5B6577AL, 0x1BDEC6EBL, 0x9534A1D1L,
+        0x3B5C3040L, 0x129484B2L, 0xBCFC1523L, 0x4105ED56L, 0xEF6D7CC7L,
+        0xC6A5C835L, 0x68CD59A4L, 0x173F7B7DL, 0xB957EAECL, 0x909F5E1EL,
+        0x3EF7CF8FL, 0xC30E37FAL, 0x6D66A66BL, 0x44AE1299L, 0xEAC68308L,
+        0x642CE432L, 0xCA4475A3L, 0xE38CC151L, 0x4DE450C0L, 0xB01DA8B5L,
+        0x1E753924L, 0x37BD8DD6L, 0x99D51C47L, 0xF11845E3L, 0x5F70D472L,
+        0x76B86080L, 0xD8D0F111L, 0x25290964L, 0x8B4198F5L, 0xA2892C07L,
+        0x0CE1BD96L, 0x820BDAACL, 0x2C634B3DL, 0x05ABFFCFL, 0xABC36E5EL,
+        0x563A962BL, 0xF85207BAL, 0xD19AB348L, 0x7FF222D9L, 0x2E7EF6FAL,
+        0x8016676BL, 0xA9DED399L, 0x07B64208L, 0xFA4FBA7DL, 0x54272BECL,
+        0x7DEF9F1EL, 0xD3870E8FL, 0x5D6D69B5L, 0xF305F824L, 0xDACD4CD6L,
+        0x74A5DD47L, 0x895C2532L, 0x2734B4A3L, 0x0EFC0051L, 0xA09491C0L,
+        0xC859C864L, 0x663159F5L, 0x4FF9ED07L, 0xE1917C96L, 0x1C6884E3L,
+        0xB2001572L, 0x9BC8A180L, 0x35A03011L, 0xBB4A572BL, 0x1522C6BAL,
+        0x3CEA7248L, 0x9282E3D9L, 0x6F7B1BACL, 0xC1138A3DL, 0xE8DB3ECFL,
+        0x46B3AF5EL, 0x39418D87L, 0x97291C16L, 0xBEE1A8E4L, 0x10893975L,
+        0xED70C100L, 0x43185091L, 0x6AD0E463L, 0xC4B875F2L, 0x4A5212C8L,
+        0xE43A8359L, 0xCDF237ABL, 0x639AA63AL, 0x9E635E4FL, 0x300BCFDEL,
+        0x19C37B2CL, 0xB7ABEABDL, 0xDF66B319L, 0x710E2288L, 0x58C6967AL,
+        0xF6AE07EBL, 0x0B57FF9EL, 0xA53F6E0FL, 0x8CF7DAFDL, 0x229F4B6CL,
+        0xAC752C56L, 0x021DBDC7L, 0x2BD50935L, 0x85BD98A4L, 0x784460D1L,
+        0xD62CF140L, 0xFFE445B2L, 0x518CD423L, 0x5CFDEDF4L, 0xF2957C65L,
+        0xDB5DC897L, 0x75355906L, 0x88CCA173L, 0x26A430E2L, 0x0F6C8410L,
+        0xA1041581L, 0x2FEE72BBL, 0x8186E32AL, 0xA84E57D8L, 0x0626C649L,
+        0xFBDF3E3CL, 0x55B7AFADL, 0x7C7F1B5FL, 0xD2178ACEL, 0xBADAD36AL,
+        0x14B242FBL, 0x3D7AF609L, 0x93126798L, 0x6EEB9FEDL, 0xC0830E7CL,
+        0xE94BBA8EL, 0x47232B1FL, 0xC9C94C25L, 0x67A1DDB4L, 0x4E696946L,
+        0xE001F8D7L, 0x1DF800A2L, 0xB3909133L, 0x9A5825C1L, 0x3430B450L,
+        0x4BC29689L, 0xE5AA0718L, 0xCC62B3EAL, 0x620A227BL, 0x9FF3DA0EL,
+        0x319B4B9FL, 0x1853FF6DL, 0xB63B6EFCL, 0x38D109C6L, 0x96B99857L,
+        0xBF712CA5L, 0x1119BD34L, 0xECE04541L, 0x4288D4D0L, 0x6B406022L,
+        0xC528F1B3L, 0xADE5A817L, 0x038D3986L, 0x2A458D74L, 0x842D1CE5L,
+        0x79D4E490L, 0xD7BC7501L, 0xFE74C1F3L, 0x501C5062L, 0xDEF63758L,
+        0x709EA6C9L, 0x5956123BL, 0xF73E83AAL, 0x0AC77BDFL, 0xA4AFEA4EL,
+        0x8D675EBCL, 0x230FCF2DL, 0x72831B0EL, 0xDCEB8A9FL, 0xF5233E6DL,
+        0x5B4BAFFCL, 0xA6B25789L, 0x08DAC618L, 0x211272EAL, 0x8F7AE37BL,
+        0x01908441L, 0xAFF815D0L, 0x8630A122L, 0x285830B3L, 0xD5A1C8C6L,
+        0x7BC95957L, 0x5201EDA5L, 0xFC697C34L, 0x94A42590L, 0x3ACCB401L,
+        0x130400F3L, 0xBD6C9162L, 0x40956917L, 0xEEFDF886L, 0xC7354C74L,
+        0x695DDDE5L, 0xE7B7BADFL, 0x49DF2B4EL, 0x60179FBCL, 0xCE7F0E2DL,
+        0x3386F658L, 0x9DEE67C9L, 0xB426D33BL, 0x1A4E42AAL, 0x65BC6073L,
+        0xCBD4F1E2L, 0xE21C4510L, 0x4C74D481L, 0xB18D2CF4L, 0x1FE5BD65L,
+        0x362D0997L, 0x98459806L, 0x16AFFF3CL, 0xB8C76EADL, 0x910FDA5FL,
+        0x3F674BCEL, 0xC29EB3BBL, 0x6CF6222AL, 0x453E96D8L, 0xEB560749L,
+        0x839B5EEDL, 0x2DF3CF7CL, 0x043B7B8EL, 0xAA53EA1FL, 0x57AA126AL,
+        0xF9C283FBL, 0xD00A3709L, 0x7E62A698L, 0xF088C1A2L, 0x5EE05033L,
+        0x7728E4C1L, 0xD9407550L, 0x24B98D25L, 0x8AD11CB4L, 0xA319A846L,
+        0x0D7139D7L
+      }
+    };
+  return lut;
+}
+
+/**
+ * Loads a 32-bit little-endian word, as the slicing tables expect.
+ */
+static inline uint32_t
+crc32_load_le32 (const uint8_t *data)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  uint32_t word;
+  memcpy (&word, data, sizeof (word));
+  return word;
+#else
+  return (uint32_t) data[0] | ((uint32_t) data[1] << 8)
+      | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+#endif
+}
+
+/**
+ * Slicing-by-8 CRC-32, eight bytes per iteration. Same polynomial and
+ * results as update_crc32().
+ *
+ * @param crc the initial feed
+ * @param data the buffer containing the data
+ * @param len the length of the buffer
+ * @return the CRC-32 result
+ */
+static inline uint32_t
+update_crc32_slice8 (uint32_t crc, const uint8_t *data, size_t len)
+{
+  const uint32_t (*lut)[256] = crc32_slice_lut ();
+
+  while (len >= 8) {
+    uint32_t one = crc32_load_le32 (data) ^ crc;
+    uint32_t two = crc32_load_le32 (data + 4);
+    crc = lut[7][one & 0xff] ^ lut[6][(one >> 8) & 0xff]
+        ^ lut[5][(one >> 16) & 0xff] ^ lut[4][one >> 24]
+        ^ lut[3][two & 0xff] ^ lut[2][(two >> 8) & 0xff]
+        ^ lut[1][(two >> 16) & 0xff] ^ lut[0][two >> 24];
+    data += 8;
+    len -= 8;
+  }
+  return update_crc32 (crc, data, len);
+}
+
+/**
+ * Slicing-by-16 CRC-32 that optionally copies the data in the same pass.
+ *
+ * @param crc the initial feed
+ * @param copy where the data is copied to, NULL for no copy
+ * @param data the buffer containing the data
+ * @param len the length of the buffer
+ * @return the CRC-32 result
+ */
+static inline uint32_t
+crc32_slice16_pass (uint32_t crc, uint8_t *copy, const uint8_t *data, size_t len)
+{
+  const uint32_t (*lut)[256] = crc32_slice_lut ();
+  size_t pos = 0;
+
+  for (; pos + 16 <= len; pos += 16) {
+    uint32_t one = crc32_load_le32 (data + pos) ^ crc;
+    uint32_t two = crc32_load_le32 (data + pos + 4);
+    uint32_t three = crc32_load_le32 (data + pos + 8);
+    uint32_t four = crc32_load_le32 (data + pos + 12);
+    if (copy != NULL)
+      memcpy (copy + pos, data + pos, 16);
+    crc = lut[15][one & 0xff] ^ lut[14][(one >> 8) & 0xff]
+        ^ lut[13][(one >> 16) & 0xff] ^ lut[12][one >> 24]
+        ^ lut[11][two & 0xff] ^ lut[10][(two >> 8) & 0xff]
+        ^ lut[9][(two >> 16) & 0xff] ^ lut[8][two >> 24]
+        ^ lut[7][three & 0xff] ^ lut[6][(three >> 8) & 0xff]
+        ^ lut[5][(three >> 16) & 0xff] ^ lut[4][three >> 24]
+        ^ lut[3][four & 0xff] ^ lut[2][(four >> 8) & 0xff]
+        ^ lut[1][(four >> 16) & 0xff] ^ lut[0][four >> 24];
+  }
+  if (copy != NULL)
+    memcpy (copy + pos, data + pos, len - pos);
+  return update_crc32_slice8 (crc, data + pos, len - pos);
+}
+
+/**
+ * Slicing-by-16 CRC-32, sixteen bytes per iteration. Same polynomial and
+ * results as update_crc32().
+ *
+ * @param crc the initial feed
+ * @param data the buffer containing the data
+ * @param len the length of the buffer
+ * @return the CRC-32 result
+ */
+static inline uint32_t
+update_crc32_slice16 (uint32_t crc, const uint8_t *data, size_t len)
+{
+  return crc32_slice16_pass (crc, NULL, data, len);
+}
+
+#ifdef CRC32_HAVE_CLMUL
+/*
+ * Folding CRC-32 with carry-less multiplication, after Intel's "Fast CRC
+ * Computation for Generic Polynomials Using PCLMULQDQ Instruction". The
+ * constants are x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32) and
+ * x^64 mod P, followed by P and floor(x^64 / P) for the Barrett
+ * reduction, all bit-reflected.
+ */
+static const uint64_t crc32_clmul_k1k2[2] __attribute__ ((aligned (16))) = { 0x0154442bd4, 0x01c6e41596 };
+static const uint64_t crc32_clmul_k3k4[2] __attribute__ ((aligned (16))) = { 0x01751997d0, 0x00ccaa009e };
+static const uint64_t crc32_clmul_k5k0[2] __attribute__ ((aligned (16))) = { 0x0163cd6124, 0x0000000000 };
+static const uint64_t crc32_clmul_poly[2] __attribute__ ((aligned (16))) = { 0x01db710641, 0x01f7011641 };
+
+/* Shortest buffer the folding kernels accept, they need a 64 byte block. */
+#define CRC32_CLMUL_MIN_LEN 64
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__ ((target ("pclmul,sse4.1")))
+static inline __m128i
+crc32_clmul_load (uint8_t *copy, const uint8_t *data, size_t pos)
+{
+  __m128i x = _mm_loadu_si128 ((const __m128i *) (data + pos));
+  if (copy != NULL)
+    _mm_storeu_si128 ((__m128i *) (copy + pos), x);
+  return x;
+}
+
+/**
+ * CRC-32 of len bytes, a multiple of 16 and at least CRC32_CLMUL_MIN_LEN,
+ * with PCLMULQDQ. The data is optionally copied in the same pass.
+ *
+ * @param crc the initial feed
+ * @param copy where the data is copied to, NULL for no copy
+ * @param data the buffer containing the data
+ * @param len the length of the buffer
+ * @return the CRC-32 result
+ */
+__attribute__ ((target ("pclmul,sse4.1")))
+static inline uint32_t
+update_crc32_clmul_kernel (uint32_t crc, uint8_t *copy, const uint8_t *data, size_t len)
+{
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+  size_t pos;
+
+  x1 = crc32_clmul_load (copy, data, 0x00);
+  x2 = crc32_clmul_load (copy, data, 0x10);
+  x3 = crc32_clmul_load (copy, data, 0x20);
+  x4 = crc32_clmul_load (copy, data, 0x30);
+  x1 = _mm_xor_si128 (x1, _mm_cvtsi32_si128 (crc));
+
+  /* Fold four 128-bit lanes in parallel. */
+  x0 = _mm_load_si128 ((const __m128i *) crc32_clmul_k1k2);
+  for (pos = 64; pos + 64 <= len; pos += 64) {
+    x5 = _mm_clmulepi64_si128 (x1, x0, 0x00);
+    x6 = _mm_clmulepi64_si128 (x2, x0, 0x00);
+    x7 = _mm_clmulepi64_si128 (x3, x0, 0x00);
+    x8 = _mm_clmulepi64_si128 (x4, x0, 0x00);
+    x1 = _mm_clmulepi64_si128 (x1, x0, 0x11);
+    x2 = _mm_clmulepi64_si128 (x2, x0, 0x11);
+    x3 = _mm_clmulepi64_si128 (x3, x0, 0x11);
+    x4 = _mm_clmulepi64_si128 (x4, x0, 0x11);
+    x1 = _mm_xor_si128 (_mm_xor_si128 (x1, x5), crc32_clmul_load (copy, data, pos + 0x00));
+    x2 = _mm_xor_si128 (_mm_xor_si128 (x2, x6), crc32_clmul_load (copy, data, pos + 0x10));
+    x3 = _mm_xor_si128 (_mm_xor_si128 (x3, x7), crc32_clmul_load (copy, data, pos + 0x20));
+    x4 = _mm_xor_si128 (_mm_xor_si128 (x4, x8), crc32_clmul_load (copy, data, pos + 0x30));
+  }
+
+  /* Fold the four lanes into one, then the remaining 16 byte blocks. */
+  x0 = _mm_load_si128 ((const __m128i *) crc32_clmul_k3k4);
+  x5 = _mm_clmulepi64_si128 (x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128 (x1, x0, 0x11);
+  x1 = _mm_xor_si128 (_mm_xor_si128 (x1, x2), x5);
+  x5 = _mm_clmulepi64_si128 (x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128 (x1, x0, 0x11);
+  x1 = _mm_xor_si128 (_mm_xor_si128 (x1, x3), x5);
+  x5 = _mm_clmulepi64_si128 (x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128 (x1, x0, 0x11);
+  x1 = _mm_xor_si128 (_mm_xor_si128 (x1, x4), x5);
+  for (; pos + 16 <= len; pos += 16) {
+    x5 = _mm_clmulepi64_si128 (x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128 (x1, x0, 0x11);
+    x1 = _mm_xor_si128 (_mm_xor_si128 (x1, crc32_clmul_load (copy, data, pos)), x5);
+  }
+
+  /* Fold 128 bits to 64. */
+  x2 = _mm_clmulepi64_si128 (x1, x0, 0x10);
+  x3 = _mm_setr_epi32 (~0, 0, ~0, 0);
+  x1 = _mm_xor_si128 (_mm_srli_si128 (x1, 8), x2);
+  x0 = _mm_loadl_epi64 ((const __m128i *) crc32_clmul_k5k0);
+  x2 = _mm_srli_si128 (x1, 4);
+  x1 = _mm_clmulepi64_si128 (_mm_and_si128 (x1, x3), x0, 0x00);
+  x1 = _mm_xor_si128 (x1, x2);
+
+  /* Barrett reduction to 32 bits. */
+  x0 = _mm_load_si128 ((const __m128i *) crc32_clmul_poly);
+  x2 = _mm_clmulepi64_si128 (_mm_and_si128 (x1, x3), x0, 0x10);
+  x2 = _mm_clmulepi64_si128 (_mm_and_si128 (x2, x3), x0, 0x00);
+  x1 = _mm_xor_si128 (x1, x2);
+
+  return _mm_extract_epi32 (x1, 1);
+}
+
+/**
+ * @return non-zero if the CPU has PCLMULQDQ and SSE4.1
+ */
+static inline int
+crc32_clmul_supported (void)
+{
+  /* Relaxed atomics, the first calls may come from several threads at once. */
+  static int supported = -1;
+  int cached = __atomic_load_n (&supported, __ATOMIC_RELAXED);
+  if (cached < 0) {
+    cached = __builtin_cpu_supports ("pclmul") && __builtin_cpu_supports ("sse4.1");
+    __atomic_store_n (&supported, cached, __ATOMIC_RELAXED);
+  }
+  return cached;
+}
+#elif defined(__aarch64__) && defined(__linux__)
+__attribute__ ((target ("+crypto")))
+static inline uint64x2_t
+crc32_pmull_lo (uint64x2_t a, uint64x2_t b)
+{
+  return vreinterpretq_u64_p128 (vmull_p64 ((poly64_t) vgetq_lane_u64 (a, 0), (poly64_t) vgetq_lane_u64 (b, 0)));
+}
+
+__attribute__ ((target ("+crypto")))
+static inline uint64x2_t
+crc32_pmull_hi (uint64x2_t a, uint64x2_t b)
+{
+  return vreinterpretq_u64_p128 (vmull_p64 ((poly64_t) vgetq_lane_u64 (a, 1), (poly64_t) vgetq_lane_u64 (b, 1)));
+}
+
+__attribute__ ((target ("+crypto")))
+static inline uint64x2_t
+crc32_pmull_fold (uint64x2_t x, uint64x2_t k, uint64x2_t next)
+{
+  return veorq_u64 (veorq_u64 (crc32_pmull_hi (x, k), crc32_pmull_lo (x, k)), next);
+}
+
+__attribute__ ((target ("+crypto")))
+static inline uint64x2_t
+crc32_pmull_load (uint8_t *copy, const uint8_t *data, size_t pos)
+{
+  uint8x16_t x = vld1q_u8 (data + pos);
+  if (copy != NULL)
+    vst1q_u8 (copy + pos, x);
+  return vreinterpretq_u64_u8 (x);
+}
+
+/**
+ * CRC-32 of len bytes, a multiple of 16 and at least CRC32_CLMUL_MIN_LEN,
+ * with PMULL. The same folding as the PCLMULQDQ kernel.
+ *
+ * @param crc the initial feed
+ * @param copy where the data is copied to, NULL for no copy
+ * @param data the buffer containing the data
+ * @param len the length of the buffer
+ * @return the CRC-32 result
+ */
+__attribute__ ((target ("+crypto")))
+static inline uint32_t
+update_crc32_clmul_kernel (uint32_t crc, uint8_t *copy, const uint8_t *data, size_t len)
+{
+  uint64x2_t x0, x1, x2, x3, x4;
+  const uint64x2_t mask = vdupq_n_u64 (0xffffffff);
+  size_t pos;
+
+  x1 = crc32_pmull_load (copy, data, 0x00);
+  x2 = crc32_pmull_load (copy, data, 0x10);
+  x3 = crc32_pmull_load (copy, data, 0x20);
+  x4 = crc32_pmull_load (copy, data, 0x30);
+  x1 = veorq_u64 (x1, vcombine_u64 (vcreate_u64 (crc), vcreate_u64 (0)));
+
+  /* Fold four 128-bit lanes in parallel. */
+  x0 = vld1q_u64 (crc32_clmul_k1k2);
+  for (pos = 64; pos + 64 <= len; pos += 64) {
+    x1 = crc32_pmull_fold (x1, x0, crc32_pmull_load (copy, data, pos + 0x00));
+    x2 = crc32_pmull_fold (x2, x0, crc32_pmull_load (copy, data, pos + 0x10));
+    x3 = crc32_pmull_fold (x3, x0, crc32_pmull_load (copy, data, pos + 0x20));
+    x4 = crc32_pmull_fold (x4, x0, crc32_pmull_load (copy, data, pos + 0x30));
+  }
+
+  /* Fold the four lanes into one, then the remaining 16 byte blocks. */
+  x0 = vld1q_u64 (crc32_clmul_k3k4);
+  x1 = crc32_pmull_fold (x1, x0, x2);
+  x1 = crc32_pmull_fold (x1, x0, x3);
+  x1 = crc32_pmull_fold (x1, x0, x4);
+  for (; pos + 16 <= len; pos += 16)
+    x1 = crc32_pmull_fold (x1, x0, crc32_pmull_load (copy, data, pos));
+
+  /* Fold 128 bits to 64. */
+  x2 = crc32_pmull_lo (x1, vcombine_u64 (vget_high_u64 (x0), vget_high_u64 (x0)));
+  x1 = veorq_u64 (vcombine_u64 (vget_high_u64 (x1), vcreate_u64 (0)), x2);
+  x0 = vld1q_u64 (crc32_clmul_k5k0);
+  x2 = vreinterpretq_u64_u8 (vextq_u8 (vreinterpretq_u8_u64 (x1), vdupq_n_u8 (0), 4));
+  x1 = veorq_u64 (crc32_pmull_lo (vandq_u64 (x1, mask), x0), x2);
+
+  /* Barrett reduction to 32 bits. */
+  x0 = vld1q_u64 (crc32_clmul_poly);
+  x2 = crc32_pmull_lo (vandq_u64 (x1, mask), vcombine_u64 (vget_high_u64 (x0), vget_high_u64 (x0)));
+  x2 = crc32_pmull_lo (vandq_u64 (x2, mask), x0);
+  x1 = veorq_u64 (x1, x2);
+
+  return vgetq_lane_u32 (vreinterpretq_u32_u64 (x1), 1);
+}
+
+/**
+ * @return non-zero if the CPU has PMULL
+ */
+static inline int
+crc32_clmul_supported (void)
+{
+  /* Relaxed atomics, the first calls may come from several threads at once. */
+  static int supported = -1;
+  int cached = __atomic_load_n (&supported, __ATOMIC_RELAXED);
+  if (cached < 0) {
+    cached = (getauxval (AT_HWCAP) & HWCAP_PMULL) != 0;
+    __atomic_store_n (&supported, cached, __ATOMIC_RELAXED);
+  }
+  return cached;
+}
+#endif
+
+/**
+ * CRC-32 with carry-less multiplication where the CPU supports it,
+ * slicing-by-16 otherwise and for the tail, optionally copying the data
+ * in the same pass.
+ *
+ * @param crc the initial feed
+ * @param copy where the data is copied to, NULL for no copy
+ * @param data the buffer containing the data
+ * @param len the length of the buffer
+ * @return the CRC-32 result
+ */
+static inline uint32_t
+crc32_fast_pass (uint32_t crc, uint8_t *copy, const uint8_t *data, size_t len)
+{
+#ifdef CRC32_HAVE_CLMUL
+  if (len >= CRC32_CLMUL_MIN_LEN && crc32_clmul_supported ()) {
+    size_t folded = len & ~(size_t) 15;
+    crc = update_crc32_clmul_kernel (crc, copy, data, folded);
+    return crc32_slice16_pass (crc, (copy != NULL) ? copy + folded : NULL, data + folded, len - folded);
+  }
+#endif
+  return crc32_slice16_pass (crc, copy, data, len);
+}
+
+/**
+ * CRC-32 with carry-less multiplication where the CPU supports it,
+ * slicing-by-16 otherwise and for the tail. Same polynomial and results
+ * as update_crc32().
+ *
+ * @param crc the initial feed
+ * @param data the buffer containing the data
+ * @param len the length of the buffer
+ * @return the CRC-32 result
+ */
+static inline uint32_t
+update_crc32_fast (uint32_t crc, const uint8_t *data, size_t len)
+{
+  return crc32_fast_pass (crc, NULL, data, len);
+}
+
+/**
+ * Copies len bytes from src to dst while computing their CRC-32, reading
+ * the data only once. Same results as update_crc32() over src.
+ *
+ * @param crc the initial feed
+ * @param dst the destination buffer, must not overlap src
+ * @param src the buffer containing the data
+ * @param len the length of the buffer
+ * @return the CRC-32 result
+ */
+static inline uint32_t
+update_crc32_copy (uint32_t crc, uint8_t *dst, const uint8_t *src, size_t len)
+{
+  return crc32_fast_pass (crc, dst, src, len);
+}
+
 /**
  * Calculates the CRC-32 of the buffer buf.
  * @param buf The buffer containing the data
@@ -103,7 +1371,7 @@ update_crc32 (uint32_t crc, const uint8_t *data, size_t len)
 static inline uint32_t
 crc32 (const uint8_t *buf, size_t len)
 {
-  unsigned int crc = update_crc32 (0xffffffff, buf, len) ^ 0xffffffff;
+  unsigned int crc = update_crc32_fast (0xffffffff, buf, len) ^ 0xffffffff;
   return crc;
 }
 